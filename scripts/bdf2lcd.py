@@ -0,0 +1,247 @@
+#!/usr/bin/env python3
+"""Convert a BDF font to a proportional lcd_font (see src/inc/font.h).
+
+usage: bdf2lcd.py font.bdf name [-o name.c] [--first 32] [--last 255]
+                  [--encoding cp1251] [--spacing 1] [--missing ?]
+       bdf2lcd.py --chargen src/uc1601s.c name [-o name.c]
+
+The font codes first..last are bytes of --encoding, they are looked up in the
+BDF by their Unicode code point (ENCODING of an ISO10646 font). Empty columns
+at the glyph sides become the bearing, a wider advance in the BDF is kept by
+padding the glyph. --chargen cuts the empty columns off the built-in 5x8
+table instead.
+
+The font gets a map of the non-ASCII code points to its codes for the UTF-8
+text functions: the ranges of --encoding, or chargen_cmap for --chargen.
+"""
+import argparse
+import re
+import sys
+
+
+def read_bdf(path):
+    """{code point: (advance, xoff, rows from the bottom of the cell)}, height"""
+    ascent = descent = None
+    bbox = None
+    glyphs = {}
+    cur = None
+    bitmap = None
+    for line in open(path, encoding='latin-1'):
+        words = line.split()
+        if not words:
+            continue
+        key = words[0]
+        if bitmap is not None:
+            if key == 'ENDCHAR':
+                cur['bitmap'] = bitmap
+                bitmap = None
+                if cur.get('encoding', -1) >= 0:
+                    glyphs[cur['encoding']] = cur
+                cur = None
+            else:
+                bitmap.append(int(key, 16))
+            continue
+        if key == 'FONT_ASCENT':
+            ascent = int(words[1])
+        elif key == 'FONT_DESCENT':
+            descent = int(words[1])
+        elif key == 'FONTBOUNDINGBOX':
+            bbox = [int(w) for w in words[1:5]]
+        elif key == 'STARTCHAR':
+            cur = {}
+        elif key == 'ENCODING' and cur is not None:
+            cur['encoding'] = int(words[1])
+        elif key == 'DWIDTH' and cur is not None:
+            cur['dwidth'] = int(words[1])
+        elif key == 'BBX' and cur is not None:
+            cur['bbx'] = [int(w) for w in words[1:5]]
+        elif key == 'BITMAP' and cur is not None:
+            bitmap = []
+    if ascent is None or descent is None:
+        if bbox is None:
+            sys.exit('%s: no FONT_ASCENT/FONT_DESCENT or FONTBOUNDINGBOX' % path)
+        ascent, descent = bbox[1] + bbox[3], -bbox[3]
+    height = ascent + descent
+
+    font = {}
+    for code, g in glyphs.items():
+        w, h, xoff, yoff = g.get('bbx', bbox)
+        bits = ((w + 7) // 8) * 8
+        # column pixels, bit 0 - the lowest row of the cell
+        cols = [0] * w
+        for i, row in enumerate(g['bitmap'][:h]):
+            y = yoff + descent + (h - 1 - i)
+            if y < 0 or y >= height:
+                continue
+            for x in range(w):
+                if (row >> (bits - 1 - x)) & 1:
+                    cols[x] |= 1 << y
+        font[code] = (g.get('dwidth', w + xoff), max(xoff, 0), cols)
+    return font, height
+
+
+def read_chargen(path):
+    """the built-in table: 5 columns of 8 rows per code 0x20..0xFF"""
+    text = open(path, encoding='latin-1').read()
+    m = re.search(r'const char chargen\[\]\s*=\s*\{(.*?)\};', text, re.S)
+    if not m:
+        sys.exit('%s: chargen[] not found' % path)
+    body = re.sub(r'//[^\n]*', '', m.group(1))
+    data = [int(v, 16) for v in re.findall(r'0x[0-9A-Fa-f]+', body)]
+    font = {}
+    for k in range(len(data) // 5):
+        cols = data[k * 5:k * 5 + 5]
+        font[0x20 + k] = (None, 0, cols)
+    return font, 8
+
+
+def trim(advance, bearing, cols, spacing):
+    """(bearing, columns) without empty sides, padded to keep the advance
+    (advance None - proportional: no bearing, a blank glyph is 3 columns wide)"""
+    while cols and not cols[0]:
+        cols = cols[1:]
+        bearing += 1
+    while cols and not cols[-1]:
+        cols = cols[:-1]
+    if advance is None:
+        return (0, cols) if cols else (max(3 - spacing, 0), [])
+    if not cols:
+        # blank glyph: the whole advance is the bearing
+        return max(advance - spacing, 0), []
+    rest = advance - bearing - len(cols)
+    if rest > spacing:
+        cols = cols + [0] * (rest - spacing)
+    return bearing, cols
+
+
+def cmap(first, last, encoding):
+    """[first code point, count, code] runs of the non-ASCII codes, sorted"""
+    runs = []
+    pairs = []
+    for code in range(max(first, 0x80), last + 1):
+        try:
+            cp = ord(bytes([code]).decode(encoding))
+        except UnicodeDecodeError:
+            continue
+        if cp >= 0x80 and cp <= 0xFFFF:
+            pairs.append((cp, code))
+    for cp, code in sorted(pairs):
+        r = runs[-1] if runs else None
+        if r and r[0] + r[1] == cp and r[2] + r[1] == code and r[1] < 255:
+            r[1] += 1
+        else:
+            runs.append([cp, 1, code])
+    if len(runs) > 255:
+        sys.exit('%s: more than 255 code point ranges' % encoding)
+    return runs
+
+
+def to_pages(cols, height):
+    pages = (height + 7) // 8
+    out = []
+    for p in range(pages):
+        out += [(c >> (8 * p)) & 0xFF for c in cols]
+    return out
+
+
+def c_array(ctype, name, values, fmt):
+    lines = ['static const %s %s[] = {' % (ctype, name)]
+    for k in range(0, len(values), 16):
+        lines.append('  ' + ', '.join(fmt % v for v in values[k:k + 16]) + ',')
+    lines.append('};')
+    return lines
+
+
+def font_c(n, source, lookup, height, first, last, spacing, missing, runs):
+    """C source of an lcd_font. lookup(code) gives (advance or None, bearing, columns)
+    or None; runs - code point ranges (see cmap), None - chargen_cmap"""
+    count = last - first + 1
+    if not 0 <= missing < count:
+        missing = 0
+
+    widths, bearings, offsets, data = [], [], [], []
+    shared = {}
+    for code in range(first, last + 1):
+        g = lookup(code)
+        if g is None:
+            g = lookup(first + missing) or (spacing + 2, 0, [])
+        bearing, cols = trim(g[0], g[1], g[2], spacing)
+        if bearing > 255 or len(cols) > 255:
+            sys.exit('code 0x%02X: glyph too wide' % code)
+        pages = to_pages(cols, height)
+        key = tuple(pages)
+        if key not in shared:
+            shared[key] = len(data)
+            data += pages
+        widths.append(len(cols))
+        bearings.append(bearing)
+        offsets.append(shared[key])
+    if len(data) > 0xFFFF:
+        sys.exit('%d bytes of glyphs, more than 64K' % len(data))
+
+    lines = ['// %s: %d glyphs 0x%02X..0x%02X, height %d, %d bytes of glyphs, made by %s'
+             % (source, count, first, last, height, len(data), sys.argv[0].split('/')[-1]),
+             '#include "inc/font.h"', '']
+    lines += c_array('uint8_t', n + '_width', widths, '%d') + ['']
+    lines += c_array('uint8_t', n + '_bearing', bearings, '%d') + ['']
+    lines += c_array('uint16_t', n + '_offset', offsets, '%d') + ['']
+    lines += c_array('uint8_t', n + '_data', data, '0x%02X') + ['']
+    map_name = '&chargen_cmap' if runs is None else '0'
+    if runs:
+        map_name = '&%s_cmap' % n
+        lines += ['static const lcd_range %s_range[] = {' % n]
+        lines += ['  {0x%04X, %d, 0x%02X},' % tuple(r) for r in runs]
+        lines += ['};', '',
+                  'static const lcd_cmap %s_cmap = {%s_range, %d};' % (n, n, len(runs)), '']
+    lines += ['const lcd_font %s = {' % n,
+              '  %d, 0x%02X, %d, %d, %d,' % (height, first, count, spacing, missing),
+              '  %s_width, %s_bearing, %s_offset, %s_data,' % (n, n, n, n),
+              '  %s' % map_name,
+              '};', '']
+    return '\n'.join(lines)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument('font', nargs='?', help='BDF file')
+    ap.add_argument('name', help='C name of the lcd_font')
+    ap.add_argument('-o', '--output', help='output .c file (default: stdout)')
+    ap.add_argument('--chargen', metavar='SRC', help='take chargen[] from this C file')
+    ap.add_argument('--first', type=lambda v: int(v, 0), default=0x20)
+    ap.add_argument('--last', type=lambda v: int(v, 0), default=0xFF)
+    ap.add_argument('--encoding', default='cp1251', help='codes of the font (default cp1251)')
+    ap.add_argument('--spacing', type=int, default=1, help='columns after every glyph')
+    ap.add_argument('--missing', default='?', help='glyph for the codes out of the font')
+    args = ap.parse_args()
+
+    if args.chargen:
+        src, height = read_chargen(args.chargen)
+        source = args.chargen + ' chargen[]'
+        lookup = lambda code: src.get(code)
+    elif args.font:
+        src, height = read_bdf(args.font)
+        source = args.font
+
+        def lookup(code):
+            try:
+                cp = ord(bytes([code]).decode(args.encoding))
+            except UnicodeDecodeError:
+                return None
+            return src.get(cp)
+    else:
+        sys.exit('a BDF file or --chargen is needed')
+    if not 0 <= args.first <= args.last <= 255:
+        sys.exit('--first/--last: codes 0..255')
+
+    missing = ord(args.missing.encode(args.encoding)[:1] or b'?') - args.first
+    runs = None if args.chargen else cmap(args.first, args.last, args.encoding)
+    text = font_c(args.name, source, lookup, height, args.first, args.last, args.spacing,
+                  missing, runs)
+    if args.output:
+        open(args.output, 'w').write(text)
+    else:
+        sys.stdout.write(text)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,206 @@
+#!/usr/bin/env python3
+"""Render the large digit fonts (see src/inc/font.h) into one C file.
+
+usage: digits2lcd.py [-o src/digits.c] [--preview NAME]
+
+digits16, digits24, digits32 - rounded stroke digits, 16/24/32 rows
+seg7_16, seg7_24, seg7_32    - 7-segment digits
+
+Codes ' ' .. ':' ("0123456789", '+', '-', '.', ':' and the space; the rest
+is blank). The heights are multiples of 8, so a font drawn at y % 8 == 0
+fills whole pages and LCD_text() writes them without reading back. Digits,
+'+', '-' and the space have one advance, so the numbers don't move when
+they change. Run by the project before every build (Keil: Options - User -
+Before Build), the output is kept in git for builds without Python.
+"""
+import argparse
+import math
+import sys
+
+from bdf2lcd import font_c
+
+FIRST, LAST = 0x20, 0x3A
+SPACING = 1
+SUB = 4  # subsamples per pixel side
+
+
+def arc(cx, cy, rx, ry, a0, a1, steps=48):
+    return [(cx + rx * math.cos(math.radians(a0 + (a1 - a0) * k / steps)),
+             cy + ry * math.sin(math.radians(a0 + (a1 - a0) * k / steps)))
+            for k in range(steps + 1)]
+
+
+def flip(strokes):
+    return [[(1 - x, 1 - y) for x, y in s] for s in strokes]
+
+
+# strokes in a unit box, y up
+SIX = [arc(0.5, 0.33, 0.5, 0.33, 0, 360), arc(0.95, 0.35, 0.95, 0.65, 180, 95)]
+STROKES = {
+    '0': [arc(0.5, 0.5, 0.5, 0.5, 0, 360)],
+    '1': [[(0.2, 0.8), (0.55, 1), (0.55, 0)], [(0.2, 0), (0.9, 0)]],
+    '2': [arc(0.5, 0.72, 0.5, 0.28, 160, -40) + [(0, 0), (1, 0)]],
+    '3': [arc(0.5, 0.75, 0.47, 0.25, 150, -90), arc(0.5, 0.27, 0.5, 0.27, 90, -150)],
+    '4': [[(0.75, 0), (0.75, 1), (0, 0.3), (1, 0.3)]],
+    '5': [[(0.95, 1), (0.12, 1), (0.117, 0.54)] + arc(0.5, 0.33, 0.5, 0.33, 140, -150)],
+    '6': SIX,
+    '7': [[(0, 1), (1, 1), (0.35, 0)]],
+    '8': [arc(0.5, 0.76, 0.42, 0.24, 0, 360), arc(0.5, 0.27, 0.5, 0.27, 0, 360)],
+    '9': flip(SIX),
+    '-': [[(0.15, 0.5), (0.85, 0.5)]],
+    '+': [[(0.1, 0.5), (0.9, 0.5)], [(0.5, 0.15), (0.5, 0.85)]],
+    '.': [[(0.5, 0), (0.5, 0)]],
+    ':': [[(0.5, 0.2), (0.5, 0.2)], [(0.5, 0.75), (0.5, 0.75)]],
+}
+
+SEGMENTS = {
+    '0': 'abcdef', '1': 'bc', '2': 'abged', '3': 'abgcd', '4': 'fgbc',
+    '5': 'afgcd', '6': 'afgedc', '7': 'abc', '8': 'abcdefg', '9': 'abcdfg',
+    '-': 'g', '+': 'gp',
+}
+
+
+def seg_dist(px, py, ax, ay, bx, by):
+    dx, dy = bx - ax, by - ay
+    if dx == 0 and dy == 0:
+        return math.hypot(px - ax, py - ay)
+    t = max(0.0, min(1.0, ((px - ax) * dx + (py - ay) * dy) / (dx * dx + dy * dy)))
+    return math.hypot(px - ax - t * dx, py - ay - t * dy)
+
+
+def inside(poly, px, py):
+    """convex polygon, counterclockwise"""
+    for k in range(len(poly)):
+        ax, ay = poly[k]
+        bx, by = poly[(k + 1) % len(poly)]
+        if (bx - ax) * (py - ay) - (by - ay) * (px - ax) < 0:
+            return False
+    return True
+
+
+def raster(width, height, hit):
+    """columns, bit 0 - the lowest row; a pixel is set when most subsamples hit"""
+    cols = []
+    for c in range(width):
+        col = 0
+        for r in range(height):
+            n = sum(hit(c + (i + 0.5) / SUB, r + (j + 0.5) / SUB)
+                    for i in range(SUB) for j in range(SUB))
+            if 2 * n >= SUB * SUB:
+                col |= 1 << r
+        cols.append(col)
+    return cols
+
+
+def stroke_glyph(ch, cell, height, t, m):
+    strokes = STROKES.get(ch)
+    if not strokes:
+        return [0] * cell
+    dot = ch in '.:'
+    r = t * (0.75 if dot else 0.5)
+    xl, xr = r + 0.3, cell - r - 0.3
+    yb, yt = m + r, height - m - r
+    pts = [[(xl + x * (xr - xl), yb + y * (yt - yb)) for x, y in s] for s in strokes]
+
+    def hit(px, py):
+        for s in pts:
+            for k in range(max(len(s) - 1, 1)):
+                a, b = s[k], s[min(k + 1, len(s) - 1)]
+                if seg_dist(px, py, a[0], a[1], b[0], b[1]) <= r:
+                    return True
+        return False
+    return raster(cell, height, hit)
+
+
+def hbar(x0, x1, y, t):
+    h = t / 2
+    return [(x0, y), (x0 + h, y - h), (x1 - h, y - h), (x1, y), (x1 - h, y + h), (x0 + h, y + h)]
+
+
+def vbar(x, y0, y1, t):
+    h = t / 2
+    return [(x, y0), (x + h, y0 + h), (x + h, y1 - h), (x, y1), (x - h, y1 - h), (x - h, y0 + h)]
+
+
+def seg7_glyph(ch, cell, height, t, m):
+    if ch in '.:':
+        # square dots of the segment thickness
+        x0 = (cell - t) / 2
+        ys = [m] if ch == '.' else [m + (height - 2 * m) * 0.25 - t / 2,
+                                    m + (height - 2 * m) * 0.75 - t / 2]
+        boxes = [[(x0, y), (x0 + t, y), (x0 + t, y + t), (x0, y + t)] for y in ys]
+    else:
+        segs = SEGMENTS.get(ch, '')
+        h, g = t / 2, 0.6  # half thickness, gap at every segment end
+        left, right = h + 0.3, cell - h - 0.3
+        bottom, top = m + h, height - m - h
+        mid = (bottom + top) / 2
+        bars = {
+            'a': hbar(left + g, right - g, top, t),
+            'g': hbar(left + g, right - g, mid, t),
+            'd': hbar(left + g, right - g, bottom, t),
+            'f': vbar(left, mid + g, top - g, t),
+            'b': vbar(right, mid + g, top - g, t),
+            'e': vbar(left, bottom + g, mid - g, t),
+            'c': vbar(right, bottom + g, mid - g, t),
+            'p': vbar((left + right) / 2, mid - (mid - bottom) * 0.6, mid + (top - mid) * 0.6, t),
+        }
+        boxes = [bars[s] for s in segs]
+
+    def hit(px, py):
+        return any(inside(b, px, py) for b in boxes)
+    return raster(cell, height, hit)
+
+
+def render(style, height):
+    t = height / 8.0
+    m = max(1, height // 16)
+    digit = int(round(height * 0.56)) + (2 if style == 'seg7' else 0)
+    narrow = max(3, int(round(t * 2)))
+    draw = stroke_glyph if style == 'stroke' else seg7_glyph
+    glyphs = {}
+    for code in range(FIRST, LAST + 1):
+        ch = chr(code)
+        cell = narrow if ch in '.:' else digit
+        if ch in '0123456789+- .:':
+            glyphs[code] = (cell + SPACING, 0, draw(ch, cell, height, t, m))
+    return glyphs
+
+
+FONTS = [('digits16', 'stroke', 16), ('digits24', 'stroke', 24), ('digits32', 'stroke', 32),
+         ('seg7_16', 'seg7', 16), ('seg7_24', 'seg7', 24), ('seg7_32', 'seg7', 32)]
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument('-o', '--output', help='output .c file (default: stdout)')
+    ap.add_argument('--preview', metavar='NAME', help='print the glyphs of a font as text')
+    args = ap.parse_args()
+
+    parts = []
+    for name, style, height in FONTS:
+        glyphs = render(style, height)
+        if args.preview == name:
+            for code in sorted(glyphs):
+                cols = glyphs[code][2]
+                print(repr(chr(code)))
+                for r in reversed(range(height)):
+                    print(''.join('#' if (c >> r) & 1 else '.' for c in cols))
+        text = font_c(name, '%s digits' % style, glyphs.get, height, FIRST, LAST, SPACING,
+                      0, [])
+        if parts:
+            # one #include for the whole file
+            lines = text.split('\n')
+            text = '\n'.join(lines[:1] + lines[3:])
+        parts.append(text)
+    if args.preview:
+        return
+    text = '\n'.join(parts)
+    if args.output:
+        open(args.output, 'w').write(text)
+    else:
+        sys.stdout.write(text)
+
+
+if __name__ == '__main__':
+    main()
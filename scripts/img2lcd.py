@@ -0,0 +1,175 @@
+#!/usr/bin/env python3
+"""Convert a monochrome image to a compressed lcd_image (see src/inc/image.h).
+
+usage: img2lcd.py image.pbm|image.png name [-o name.c] [--invert] [--threshold 128]
+
+PBM (P1/P4) is read directly, other formats need Pillow. Dark pixels become
+black (set) pixels. Page 0 holds the bottom rows, bit 0 is the lowest row of a page
+(y grows up on the display). The height is padded to a multiple of 8 rows at the top.
+"""
+import argparse
+import sys
+
+
+def read_pbm(path):
+    data = open(path, 'rb').read()
+    tokens = []
+    pos = 0
+
+    def token():
+        nonlocal pos
+        while True:
+            while data[pos:pos + 1].isspace():
+                pos += 1
+            if data[pos:pos + 1] == b'#':
+                while data[pos:pos + 1] not in (b'\n', b''):
+                    pos += 1
+                continue
+            break
+        start = pos
+        while pos < len(data) and not data[pos:pos + 1].isspace():
+            pos += 1
+        return data[start:pos]
+
+    magic = token()
+    width, height = int(token()), int(token())
+    rows = []
+    if magic == b'P4':
+        pos += 1  # single whitespace after the header
+        stride = (width + 7) // 8
+        for y in range(height):
+            line = data[pos + y * stride:pos + (y + 1) * stride]
+            rows.append([(line[x >> 3] >> (7 - (x & 7))) & 1 for x in range(width)])
+    elif magic == b'P1':
+        bits = [c for c in data[pos:] if c in b'01']
+        for y in range(height):
+            rows.append([bits[y * width + x] - ord('0') for x in range(width)])
+    else:
+        raise ValueError('%s: not a PBM (P1/P4) file' % path)
+    return width, height, rows
+
+
+def read_image(path, threshold):
+    if path.lower().endswith('.pbm'):
+        return read_pbm(path)
+    try:
+        from PIL import Image
+    except ImportError:
+        sys.exit('Pillow is needed for %s (or convert it to PBM)' % path)
+    img = Image.open(path).convert('L')
+    width, height = img.size
+    px = img.load()
+    rows = [[1 if px[x, y] < threshold else 0 for x in range(width)]
+            for y in range(height)]
+    return width, height, rows
+
+
+def to_pages(width, height, rows):
+    pages = (height + 7) // 8
+    out = []
+    for p in range(pages):
+        for x in range(width):
+            byte = 0
+            for bit in range(8):
+                y = height - 1 - (p * 8 + bit)  # rows[] go top down
+                if y >= 0 and rows[y][x]:
+                    byte |= 1 << bit
+            out.append(byte)
+    return pages, out
+
+
+def compress(src):
+    """Greedy encoder for the decoder of src/image.c"""
+    out = []
+    lit = []
+
+    def flush_literal():
+        while lit:
+            chunk = lit[:128]
+            del lit[:128]
+            out.append(len(chunk) - 1)
+            out.extend(chunk)
+
+    i = 0
+    while i < len(src):
+        run = 1
+        while i + run < len(src) and run < 65 and src[i + run] == src[i]:
+            run += 1
+        best_len, best_dist = 0, 0
+        for dist in range(1, min(i, 256) + 1):
+            n = 0
+            while i + n < len(src) and n < 66 and src[i + n - dist] == src[i + n]:
+                n += 1
+            if n > best_len:
+                best_len, best_dist = n, dist
+        if best_len >= 3 and best_len > run:
+            flush_literal()
+            out += [0xC0 | (best_len - 3), best_dist - 1]
+            i += best_len
+        elif run >= 3 or (run == 2 and not lit):
+            flush_literal()
+            out += [0x80 | (run - 2), src[i]]
+            i += run
+        else:
+            lit.append(src[i])
+            i += 1
+    flush_literal()
+    return out
+
+
+def decompress(stream, size):
+    out = []
+    i = 0
+    while len(out) < size:
+        t = stream[i]
+        i += 1
+        if t < 0x80:
+            out += stream[i:i + t + 1]
+            i += t + 1
+        elif t < 0xC0:
+            out += [stream[i]] * ((t & 0x3F) + 2)
+            i += 1
+        else:
+            dist = stream[i] + 1
+            i += 1
+            for _ in range((t & 0x3F) + 3):
+                out.append(out[-dist])
+    return out[:size]
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument('image')
+    ap.add_argument('name', help='C name of the lcd_image')
+    ap.add_argument('-o', '--output', help='output .c file (default: stdout)')
+    ap.add_argument('--invert', action='store_true')
+    ap.add_argument('--threshold', type=int, default=128)
+    args = ap.parse_args()
+
+    width, height, rows = read_image(args.image, args.threshold)
+    if width > 132 or height > 64:
+        sys.exit('%dx%d is larger than the display (132x64)' % (width, height))
+    if args.invert:
+        rows = [[1 - v for v in row] for row in rows]
+    pages, raw = to_pages(width, height, rows)
+    stream = compress(raw)
+    assert decompress(stream, len(raw)) == raw
+
+    lines = ['// %s: %dx%d, %d -> %d bytes, made by img2lcd.py'
+             % (args.image, width, height, len(raw), len(stream)),
+             '#include "inc/image.h"', '',
+             'static const uint8_t %s_data[] = {' % args.name]
+    for k in range(0, len(stream), 16):
+        lines.append('  ' + ', '.join('0x%02X' % b for b in stream[k:k + 16]) + ',')
+    lines += ['};', '',
+              'const lcd_image %s = { %d, %d, sizeof(%s_data), %s_data };'
+              % (args.name, width, pages, args.name, args.name), '']
+    text = '\n'.join(lines)
+    if args.output:
+        open(args.output, 'w').write(text)
+    else:
+        sys.stdout.write(text)
+
+
+if __name__ == '__main__':
+    main()
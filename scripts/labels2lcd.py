@@ -0,0 +1,166 @@
+#!/usr/bin/env python3
+"""Pre-render the constant labels of the sources into lcd_bitmaps (see src/inc/image.h).
+
+usage: labels2lcd.py [sources.c ...] [-o src/labels.c] [--header src/inc/labels.h]
+
+A label is marked where it is drawn:
+
+    LCD_blit(LCD_LABEL(label_hello, FONT_TYPE_5x8, "Hello world!"), 0, 56, ROP_TYPE_COPY);
+
+LCD_LABEL() is &label_hello, the bitmap made here, so drawing the label is one blit.
+The font is a FONT_TYPE_* (the chargen[] symbols exactly as LCD_string() prints
+them, the separator columns included) or an lcd_font of the sources (as LCD_text()
+prints it). The bitmap's y is the lowest row of the text, the same as for
+LCD_string() and LCD_text(). Run by the project before every build (Keil:
+Options - User - Before Build), the output is kept in git.
+"""
+import argparse
+import glob
+import os
+import re
+import sys
+
+from bdf2lcd import read_chargen, c_array
+
+LABEL = re.compile(r'LCD_LABEL\(\s*(\w+)\s*,\s*(\w+)\s*,\s*"((?:[^"\\]|\\.)*)"\s*\)')
+
+# chargen[] scale of LCD_string(): (width, height) as in LCD_symbol()
+CHARGEN = {'FONT_TYPE_5x8': (1, 0), 'FONT_TYPE_5x15': (1, 1),
+           'FONT_TYPE_10x15': (2, 1), 'FONT_TYPE_10x8': (2, 0)}
+
+
+def unescape(s, where):
+    out = []
+    k = 0
+    while k < len(s):
+        c = s[k]
+        if c != '\\':
+            out.append(ord(c))
+            k += 1
+            continue
+        m = re.match(r'x([0-9A-Fa-f]{1,2})|([0-7]{1,3})|(["\'\\?])', s[k + 1:])
+        if not m:
+            sys.exit('%s: unsupported escape in a label: %s' % (where, s[k:k + 2]))
+        if m.group(1):
+            out.append(int(m.group(1), 16))
+        elif m.group(2):
+            out.append(int(m.group(2), 8))
+        else:
+            out.append(ord(m.group(3)))
+        k += 1 + m.end()
+    return out
+
+
+def read_fonts(sources):
+    """lcd_fonts of the C sources: name -> (height, first, count, spacing, missing,
+    widths, bearings, offsets, data)"""
+    fonts = {}
+    arrays = {}
+    text = ''
+    for path in sources:
+        text += open(path, encoding='latin-1').read() + '\n'
+    for m in re.finditer(r'static const uint(?:8|16)_t (\w+)\[\] = \{(.*?)\};', text, re.S):
+        arrays[m.group(1)] = [int(v, 0) for v in re.findall(r'0x[0-9A-Fa-f]+|\d+', m.group(2))]
+    for m in re.finditer(r'const lcd_font (\w+) = \{\s*(\d+), (0x[0-9A-Fa-f]+|\d+), (\d+), '
+                         r'(\d+), (\d+),\s*(\w+), (\w+), (\w+), (\w+)', text):
+        name = m.group(1)
+        height, first, count, spacing, missing = [int(m.group(k), 0) for k in range(2, 7)]
+        try:
+            tables = [arrays[m.group(k)] for k in range(7, 11)]
+        except KeyError:
+            continue
+        fonts[name] = (height, first, count, spacing, missing) + tuple(tables)
+    return fonts
+
+
+def render_chargen(codes, scale, chargen):
+    """columns of LCD_string(): every symbol is 5 * width columns and a cleared separator"""
+    width, height = scale
+    cols = []
+    for code in codes:
+        glyph = chargen.get(code, (None, 0, [0] * 5))[2]
+        for byte in glyph:
+            col = 0
+            for r in range(8):
+                if (byte >> r) & 1:
+                    col |= (3 if height else 1) << (r * 2 if height else r)
+            cols += [col] * width
+        cols.append(0)
+    return cols, 16 if height else 8
+
+
+def render_font(codes, font):
+    """columns of LCD_text()"""
+    height, first, count, spacing, missing, widths, bearings, offsets, data = font
+    pages = (height + 7) // 8
+    cols = []
+    for code in codes:
+        g = code - first if first <= code < first + count else missing
+        w = widths[g]
+        cols += [0] * bearings[g]
+        for c in range(w):
+            col = 0
+            for p in range(pages):
+                col |= data[offsets[g] + p * w + c] << (8 * p)
+            cols.append(col & ((1 << height) - 1))
+        cols += [0] * spacing
+    return cols[:len(cols) - spacing] if codes else [], height
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument('sources', nargs='*', help='C files to scan (default: src/*.c)')
+    ap.add_argument('-o', '--output', default='src/labels.c')
+    ap.add_argument('--header', default='src/inc/labels.h')
+    ap.add_argument('--chargen', default='src/uc1601s.c', help='file with chargen[]')
+    args = ap.parse_args()
+
+    sources = args.sources or sorted(glob.glob('src/*.c'))
+    sources = [s for s in sources if os.path.basename(s) != os.path.basename(args.output)]
+    chargen, _ = read_chargen(args.chargen)
+    fonts = read_fonts(sources)
+
+    labels = {}
+    for path in sources:
+        text = open(path, encoding='latin-1').read()
+        for m in LABEL.finditer(text):
+            name, font = m.group(1), m.group(2)
+            where = '%s:%d' % (path, text.count('\n', 0, m.start()) + 1)
+            codes = unescape(m.group(3), where)
+            if name in labels and labels[name][:2] != (font, codes):
+                sys.exit('%s: label %s is already made of another text' % (where, name))
+            if font in CHARGEN:
+                cols, height = render_chargen(codes, CHARGEN[font], chargen)
+            elif font in fonts:
+                cols, height = render_font(codes, fonts[font])
+            else:
+                sys.exit('%s: unknown font %s' % (where, font))
+            if not cols or len(cols) > 255:
+                sys.exit('%s: label %s is %d columns wide' % (where, name, len(cols)))
+            labels[name] = (font, codes, cols, height)
+
+    out = ['// %d labels of the sources, made by labels2lcd.py' % len(labels),
+           '#include "inc/labels.h"', '']
+    for name in sorted(labels):
+        font, codes, cols, height = labels[name]
+        data = []
+        for p in range((height + 7) // 8):
+            data += [(c >> (8 * p)) & 0xFF for c in cols]
+        out.append('// %s %s' % (font, ''.join(chr(c) if 0x20 <= c < 0x7F else '\\x%02X' % c
+                                               for c in codes)))
+        out += c_array('uint8_t', name + '_data', data, '0x%02X')
+        out += ['const lcd_bitmap %s = {%d, %d, %s_data};' % (name, len(cols), height, name), '']
+    open(args.output, 'w').write('\n'.join(out))
+
+    hdr = ['#ifndef __LABELS_H', '#define __LABELS_H', '', '#include "image.h"', '',
+           '// Constant text pre-rendered by scripts/labels2lcd.py, drawn with LCD_blit().',
+           '// The build finds LCD_LABEL(name, font, "text") in the sources and makes the',
+           '// bitmap "name", the macro is its address.',
+           '#define LCD_LABEL(name, font, text) (&name)', '']
+    hdr += ['extern const lcd_bitmap %s;' % name for name in sorted(labels)]
+    hdr += ['', '#endif //__LABELS_H', '']
+    open(args.header, 'w').write('\n'.join(hdr))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,355 @@
+// stroke digits: 27 glyphs 0x20..0x3A, height 16, 220 bytes of glyphs, made by digits2lcd.py
+#include "inc/font.h"
+
+static const uint8_t digits16_width[] = {
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 8, 0, 8, 4, 0,
+  9, 7, 9, 8, 9, 8, 9, 9, 9, 9, 4,
+};
+
+static const uint8_t digits16_bearing[] = {
+  9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 1, 9, 1, 0, 9,
+  0, 2, 0, 1, 0, 1, 0, 0, 0, 0, 0,
+};
+
+static const uint16_t digits16_offset[] = {
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 16, 32, 0,
+  40, 58, 72, 90, 106, 124, 140, 158, 176, 194, 212,
+};
+
+static const uint8_t digits16_data[] = {
+  0x80, 0x80, 0xF0, 0xF8, 0xF0, 0x80, 0x80, 0x00, 0x01, 0x01, 0x0F, 0x1F, 0x0F, 0x01, 0x01, 0x00,
+  0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00,
+  0x04, 0x0E, 0x0E, 0x04, 0x00, 0x00, 0x00, 0x00, 0xC0, 0xF8, 0x3C, 0x0E, 0x06, 0x0E, 0x3C, 0xF8,
+  0xC0, 0x03, 0x1F, 0x3C, 0x70, 0x60, 0x70, 0x3C, 0x1F, 0x03, 0x06, 0x06, 0xFE, 0xFE, 0x06, 0x06,
+  0x00, 0x18, 0x38, 0x7F, 0x7F, 0x00, 0x00, 0x00, 0x06, 0x0E, 0x1E, 0x3E, 0x76, 0xE6, 0xC6, 0x06,
+  0x06, 0x00, 0x38, 0x78, 0x60, 0x60, 0x60, 0x7B, 0x3F, 0x0E, 0x1C, 0x0E, 0x06, 0x86, 0x86, 0xCE,
+  0xFC, 0x30, 0x30, 0x70, 0x61, 0x63, 0x61, 0x7F, 0x3F, 0x0C, 0x20, 0xF0, 0xF0, 0xF0, 0x70, 0xFE,
+  0xFE, 0x70, 0x20, 0x00, 0x00, 0x03, 0x0F, 0x1E, 0x7F, 0x7F, 0x00, 0x00, 0x1C, 0x1C, 0x06, 0x06,
+  0x06, 0x9C, 0xFC, 0x70, 0x7F, 0x7F, 0x66, 0x66, 0x66, 0x63, 0x61, 0x00, 0xF0, 0xFC, 0x9C, 0x06,
+  0x06, 0x06, 0x9C, 0xFC, 0x70, 0x00, 0x07, 0x1F, 0x3E, 0x36, 0x76, 0x63, 0x61, 0x00, 0x00, 0x00,
+  0x00, 0x1E, 0xFC, 0xE0, 0x80, 0x00, 0x00, 0x60, 0x60, 0x60, 0x60, 0x60, 0x67, 0x7F, 0x7C, 0x60,
+  0x70, 0xFC, 0xCE, 0x86, 0x86, 0x86, 0xCE, 0xFC, 0x70, 0x00, 0x1E, 0x3F, 0x63, 0x63, 0x63, 0x3F,
+  0x1E, 0x00, 0x00, 0x86, 0xC6, 0x6E, 0x6C, 0x7C, 0xF8, 0xE0, 0x00, 0x0E, 0x3F, 0x39, 0x60, 0x60,
+  0x60, 0x39, 0x3F, 0x0F, 0x10, 0x38, 0x38, 0x10, 0x00, 0x0E, 0x0E, 0x00,
+};
+
+const lcd_font digits16 = {
+  16, 0x20, 27, 1, 0,
+  digits16_width, digits16_bearing, digits16_offset, digits16_data,
+  0
+};
+
+// stroke digits: 27 glyphs 0x20..0x3A, height 24, 477 bytes of glyphs, made by digits2lcd.py
+static const uint8_t digits24_width[] = {
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 12, 0, 11, 5, 0,
+  13, 11, 13, 12, 13, 12, 13, 13, 13, 13, 5,
+};
+
+static const uint8_t digits24_bearing[] = {
+  13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 1, 13, 2, 1, 13,
+  0, 2, 0, 1, 0, 1, 0, 0, 0, 0, 1,
+};
+
+static const uint16_t digits24_offset[] = {
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 36, 69, 0,
+  84, 123, 156, 195, 231, 270, 306, 345, 384, 423, 462,
+};
+
+static const uint8_t digits24_data[] = {
+  0x00, 0x00, 0x00, 0x00, 0xF0, 0xF0, 0xF0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x18, 0x3C, 0x3C,
+  0xFF, 0xFF, 0xFF, 0x3C, 0x3C, 0x18, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0F, 0x0F, 0x0F, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18,
+  0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x1C, 0x1E, 0x1E, 0x1C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0xE0, 0xF8, 0xFC, 0x3C, 0x1E, 0x0E, 0x1E, 0x3C, 0xFC, 0xF8, 0xE0,
+  0x00, 0x7E, 0xFF, 0xFF, 0xC3, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC3, 0xFF, 0xFF, 0x7E, 0x00, 0x07,
+  0x1F, 0x3F, 0x3C, 0x78, 0x70, 0x78, 0x3C, 0x3F, 0x1F, 0x07, 0x00, 0x04, 0x0E, 0x0E, 0xFE, 0xFE,
+  0xFE, 0xFE, 0x0E, 0x0E, 0x04, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00,
+  0x00, 0x06, 0x0F, 0x1F, 0x3F, 0x7F, 0x7F, 0x3F, 0x00, 0x00, 0x00, 0x00, 0x04, 0x1E, 0x3E, 0x7E,
+  0xFE, 0xEE, 0xCE, 0x8E, 0x0E, 0x0E, 0x0E, 0x0E, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x07,
+  0x0F, 0x1F, 0x7C, 0xF8, 0xF0, 0xC0, 0x00, 0x0E, 0x1E, 0x3E, 0x78, 0x70, 0x70, 0x70, 0x78, 0x3E,
+  0x1F, 0x0F, 0x03, 0x30, 0x78, 0x3C, 0x1E, 0x0E, 0x0E, 0x0E, 0x1E, 0x3C, 0xF8, 0xF0, 0xC0, 0x00,
+  0x00, 0x00, 0x00, 0x38, 0x3C, 0x38, 0x3C, 0xFE, 0xFF, 0xEF, 0x01, 0x0C, 0x1C, 0x3C, 0x78, 0x70,
+  0x70, 0x70, 0x78, 0x3F, 0x1F, 0x0F, 0x01, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0xFC, 0xFE,
+  0xFE, 0x80, 0x80, 0x80, 0x01, 0x07, 0x1F, 0x7F, 0xFF, 0xF3, 0xC3, 0xFF, 0xFF, 0xFF, 0x03, 0x03,
+  0x01, 0x00, 0x00, 0x00, 0x00, 0x01, 0x03, 0x0F, 0x3F, 0x7F, 0x7F, 0x00, 0x00, 0x00, 0x70, 0x78,
+  0x7C, 0x1E, 0x0E, 0x0E, 0x0E, 0x1E, 0x7C, 0xF8, 0xF0, 0x80, 0xF0, 0xF8, 0xF8, 0xF0, 0xE0, 0xE0,
+  0xE0, 0xF0, 0xFC, 0x7F, 0x1F, 0x07, 0x3F, 0x7F, 0x7F, 0x7F, 0x70, 0x71, 0x70, 0x70, 0x70, 0x70,
+  0x70, 0x00, 0x80, 0xF0, 0xF8, 0x7C, 0x1E, 0x0E, 0x0E, 0x0E, 0x1E, 0x7C, 0xF8, 0xF0, 0x80, 0x0F,
+  0xFF, 0xFF, 0xFC, 0xF0, 0xE0, 0xE0, 0xE0, 0xF0, 0xFC, 0x7F, 0x1F, 0x07, 0x00, 0x00, 0x03, 0x07,
+  0x0F, 0x1F, 0x3D, 0x38, 0x78, 0x70, 0x70, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3E, 0xFE, 0xFC,
+  0xE0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x0F, 0x7F, 0xFF, 0xF8,
+  0xC0, 0x00, 0x00, 0x20, 0x70, 0x70, 0x70, 0x70, 0x70, 0x70, 0x70, 0x73, 0x7F, 0x7F, 0x7C, 0x20,
+  0xC0, 0xF0, 0xF8, 0x7C, 0x1E, 0x0E, 0x0E, 0x0E, 0x1E, 0x7C, 0xF8, 0xF0, 0xC0, 0x01, 0x8F, 0xFF,
+  0xFE, 0x7C, 0x38, 0x38, 0x38, 0x7C, 0xFE, 0xFF, 0x8F, 0x01, 0x00, 0x07, 0x1F, 0x3F, 0x78, 0x70,
+  0x70, 0x70, 0x78, 0x3F, 0x1F, 0x07, 0x00, 0x00, 0x04, 0x0E, 0x0E, 0x1E, 0x1C, 0xBC, 0xF8, 0xF0,
+  0xE0, 0xC0, 0x00, 0x00, 0xE0, 0xF8, 0xFE, 0x3F, 0x0F, 0x07, 0x07, 0x07, 0x0F, 0x3F, 0xFF, 0xFF,
+  0xF0, 0x01, 0x0F, 0x1F, 0x3E, 0x78, 0x70, 0x70, 0x70, 0x78, 0x3E, 0x1F, 0x0F, 0x01, 0xE0, 0xE0,
+  0xE0, 0xE0, 0x00, 0x80, 0xC1, 0xC1, 0x80, 0x00, 0x03, 0x07, 0x07, 0x03, 0x00,
+};
+
+const lcd_font digits24 = {
+  24, 0x20, 27, 1, 0,
+  digits24_width, digits24_bearing, digits24_offset, digits24_data,
+  0
+};
+
+// stroke digits: 27 glyphs 0x20..0x3A, height 32, 884 bytes of glyphs, made by digits2lcd.py
+static const uint8_t digits32_width[] = {
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 16, 0, 16, 7, 0,
+  18, 15, 18, 17, 18, 17, 18, 18, 18, 18, 7,
+};
+
+static const uint8_t digits32_bearing[] = {
+  18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 2, 18, 2, 1, 18,
+  0, 3, 0, 1, 0, 1, 0, 0, 0, 0, 1,
+};
+
+static const uint16_t digits32_offset[] = {
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 64, 128, 0,
+  156, 228, 288, 360, 428, 500, 568, 640, 712, 784, 856,
+};
+
+static const uint8_t digits32_data[] = {
+  0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0xC0, 0xC0, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xFF, 0xFF, 0xFF, 0xFF, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0x00, 0x00,
+  0x03, 0x03, 0x03, 0x03, 0x03, 0xFF, 0xFF, 0xFF, 0xFF, 0x03, 0x03, 0x03, 0x03, 0x03, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x03, 0x03, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x80, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0x80, 0x00, 0x00,
+  0x01, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x01, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x78, 0xFC, 0xFC, 0xFC, 0xFC, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0xE0,
+  0xF0, 0xF8, 0xF8, 0x7C, 0x3C, 0x3C, 0x7C, 0xF8, 0xF8, 0xF0, 0xE0, 0xC0, 0x00, 0x00, 0xE0, 0xFE,
+  0xFF, 0xFF, 0x3F, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x3F, 0xFF, 0xFF, 0xFE, 0xE0,
+  0x07, 0x7F, 0xFF, 0xFF, 0xFC, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0xFC, 0xFF, 0xFF,
+  0x7F, 0x07, 0x00, 0x00, 0x03, 0x07, 0x0F, 0x1F, 0x1F, 0x3E, 0x3C, 0x3C, 0x3E, 0x1F, 0x1F, 0x0F,
+  0x07, 0x03, 0x00, 0x00, 0x18, 0x3C, 0x3C, 0x3C, 0x3C, 0xFC, 0xFC, 0xFC, 0xFC, 0x3C, 0x3C, 0x3C,
+  0x3C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0xC0, 0xE0, 0xE0, 0xC0, 0x80, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x01, 0x03, 0x07, 0x0F, 0x1F, 0x3F, 0x3F, 0x3F, 0x1F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x18, 0x3C, 0x7C, 0xFC, 0xFC, 0xFC, 0xFC, 0xBC, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C,
+  0x3C, 0x18, 0x00, 0x00, 0x00, 0x00, 0x01, 0x03, 0x0F, 0x1F, 0x3F, 0x7E, 0xFC, 0xF8, 0xF0, 0xE0,
+  0xC0, 0x80, 0x00, 0x00, 0x00, 0xC0, 0xC0, 0xC0, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01,
+  0x03, 0xCF, 0xFF, 0xFF, 0xFE, 0x78, 0x00, 0x03, 0x07, 0x0F, 0x1F, 0x1F, 0x3E, 0x3C, 0x3C, 0x3C,
+  0x3C, 0x3E, 0x1F, 0x1F, 0x0F, 0x07, 0x03, 0x00, 0xC0, 0xE0, 0xF0, 0xF8, 0xF8, 0x7C, 0x3C, 0x3C,
+  0x3C, 0x3C, 0x7C, 0xF8, 0xF8, 0xF0, 0xE0, 0xC0, 0x00, 0x00, 0x01, 0x01, 0x01, 0x00, 0x00, 0x80,
+  0xC0, 0xC0, 0xC0, 0xC0, 0xE0, 0xF1, 0xFF, 0xFF, 0x7F, 0x0E, 0x00, 0x80, 0x80, 0x80, 0x00, 0x00,
+  0x03, 0x07, 0x07, 0x07, 0x07, 0x0F, 0xFF, 0xFF, 0xFE, 0xFC, 0x00, 0x00, 0x07, 0x0F, 0x1F, 0x1F,
+  0x3E, 0x3C, 0x3C, 0x3C, 0x3C, 0x3E, 0x1F, 0x1F, 0x0F, 0x07, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF8, 0xFC, 0xFC, 0xFC, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x3E,
+  0xFE, 0xFE, 0xFE, 0xFE, 0xDE, 0x1E, 0x1E, 0x1E, 0xFF, 0xFF, 0xFF, 0xFF, 0x1E, 0x1E, 0x1E, 0x0C,
+  0x00, 0x00, 0x00, 0x01, 0x07, 0x1F, 0x3F, 0xFF, 0xFC, 0xF8, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x07, 0x1F, 0x3F, 0x3F, 0x3F,
+  0x00, 0x00, 0x00, 0x00, 0x80, 0xE0, 0xF0, 0xF8, 0xF8, 0x7C, 0x3C, 0x3C, 0x3C, 0x3C, 0x7C, 0xF8,
+  0xF8, 0xF0, 0xE0, 0x80, 0x00, 0x01, 0x03, 0x83, 0x81, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0xE7, 0xFF, 0xFF, 0xFF, 0x3C, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0x1E, 0x3E, 0x3C, 0x3C, 0x3E,
+  0x1E, 0x1F, 0x0F, 0x0F, 0x07, 0x01, 0x00, 0x00, 0x1F, 0x3F, 0x3F, 0x3F, 0x3C, 0x3C, 0x3C, 0x3C,
+  0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x18, 0x00, 0x00, 0x80, 0xE0, 0xF0, 0xF8, 0xF8, 0x7C, 0x3C,
+  0x3C, 0x3C, 0x3C, 0x7C, 0xF8, 0xF8, 0xF0, 0xE0, 0x80, 0x00, 0xFC, 0xFF, 0xFF, 0xFF, 0xE7, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xE7, 0xFF, 0xFF, 0xFF, 0x3C, 0x00, 0x07, 0x3F, 0x7F,
+  0xFF, 0xFF, 0xFE, 0xFE, 0xBC, 0x3C, 0x3E, 0x1E, 0x1F, 0x0F, 0x0F, 0x07, 0x01, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x01, 0x03, 0x07, 0x0F, 0x0F, 0x1F, 0x1E, 0x1E, 0x3C, 0x3C, 0x3C, 0x18, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x38, 0xFC, 0xFC, 0xF8, 0xE0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x07, 0x3F, 0xFF, 0xFF, 0xF8, 0xE0, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x0F, 0x3F,
+  0xFF, 0xFF, 0xF8, 0xC0, 0x00, 0x00, 0x18, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C,
+  0x3C, 0x3C, 0x3D, 0x3F, 0x3F, 0x3F, 0x3F, 0x18, 0x00, 0xC0, 0xE0, 0xF0, 0xF8, 0xF8, 0x7C, 0x3C,
+  0x3C, 0x3C, 0x3C, 0x7C, 0xF8, 0xF8, 0xF0, 0xE0, 0xC0, 0x00, 0x0E, 0x7F, 0xFF, 0xFF, 0xF1, 0xE0,
+  0xC0, 0x80, 0xC0, 0xC0, 0x80, 0xC0, 0xE0, 0xF1, 0xFF, 0xFF, 0x7F, 0x0E, 0x00, 0xE0, 0xFC, 0xFF,
+  0xFF, 0xFF, 0x0F, 0x07, 0x07, 0x07, 0x07, 0x0F, 0xFF, 0xFF, 0xFF, 0xFC, 0xE0, 0x00, 0x00, 0x00,
+  0x03, 0x0F, 0x1F, 0x1F, 0x3E, 0x3C, 0x3C, 0x3C, 0x3C, 0x3E, 0x1F, 0x1F, 0x0F, 0x03, 0x00, 0x00,
+  0x00, 0x00, 0x18, 0x3C, 0x3C, 0x3C, 0x78, 0x78, 0xF8, 0xF0, 0xF0, 0xE0, 0xC0, 0x80, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x80, 0xE0, 0xF0, 0xF0, 0xF8, 0x78, 0x7C, 0x3C, 0x3D, 0x7F, 0x7F, 0xFF, 0xFF,
+  0xFE, 0xFC, 0xE0, 0x00, 0x3C, 0xFF, 0xFF, 0xFF, 0xE7, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0xE7, 0xFF, 0xFF, 0xFF, 0x3F, 0x00, 0x01, 0x07, 0x0F, 0x1F, 0x1F, 0x3E, 0x3C, 0x3C, 0x3C,
+  0x3C, 0x3E, 0x1F, 0x1F, 0x0F, 0x07, 0x01, 0x00, 0x00, 0x80, 0xC0, 0xC0, 0x80, 0x00, 0x00, 0x07,
+  0x0F, 0x0F, 0x0F, 0x0F, 0x07, 0x00, 0x70, 0xF8, 0xF8, 0xF8, 0xF8, 0x70, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00,
+};
+
+const lcd_font digits32 = {
+  32, 0x20, 27, 1, 0,
+  digits32_width, digits32_bearing, digits32_offset, digits32_data,
+  0
+};
+
+// seg7 digits: 27 glyphs 0x20..0x3A, height 16, 242 bytes of glyphs, made by digits2lcd.py
+static const uint8_t seg7_16_width[] = {
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 9, 0, 9, 3, 0,
+  11, 2, 11, 9, 11, 11, 11, 9, 11, 11, 3,
+};
+
+static const uint8_t seg7_16_bearing[] = {
+  11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 2, 11, 2, 1, 11,
+  0, 9, 0, 2, 0, 0, 0, 2, 0, 0, 1,
+};
+
+static const uint16_t seg7_16_offset[] = {
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 18, 36, 0,
+  42, 64, 68, 90, 108, 130, 152, 174, 192, 214, 236,
+};
+
+static const uint8_t seg7_16_data[] = {
+  0x80, 0x80, 0xC0, 0xE0, 0xC0, 0x80, 0x80, 0x00, 0x00, 0x01, 0x01, 0x03, 0x07, 0x03, 0x01, 0x01,
+  0x00, 0x00, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01,
+  0x01, 0x01, 0x00, 0x00, 0x06, 0x06, 0x00, 0x00, 0x00, 0x00, 0x78, 0x78, 0x06, 0x06, 0x06, 0x06,
+  0x06, 0x06, 0x06, 0x78, 0x78, 0x1E, 0x1E, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x1E, 0x1E,
+  0x78, 0x78, 0x1E, 0x1E, 0x78, 0x78, 0x86, 0x86, 0x86, 0x86, 0x86, 0x86, 0x86, 0x00, 0x00, 0x00,
+  0x00, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61, 0x1E, 0x1E, 0x86, 0x86, 0x86, 0x86, 0x86, 0x86,
+  0x86, 0x78, 0x78, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61, 0x1E, 0x1E, 0x00, 0x00, 0x80, 0x80,
+  0x80, 0x80, 0x80, 0x80, 0x80, 0x78, 0x78, 0x1E, 0x1E, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+  0x1E, 0x1E, 0x00, 0x00, 0x86, 0x86, 0x86, 0x86, 0x86, 0x86, 0x86, 0x78, 0x78, 0x1E, 0x1E, 0x61,
+  0x61, 0x61, 0x61, 0x61, 0x61, 0x61, 0x00, 0x00, 0x78, 0x78, 0x86, 0x86, 0x86, 0x86, 0x86, 0x86,
+  0x86, 0x78, 0x78, 0x1E, 0x1E, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x78, 0x78, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x1E, 0x1E,
+  0x78, 0x78, 0x86, 0x86, 0x86, 0x86, 0x86, 0x86, 0x86, 0x78, 0x78, 0x1E, 0x1E, 0x61, 0x61, 0x61,
+  0x61, 0x61, 0x61, 0x61, 0x1E, 0x1E, 0x00, 0x00, 0x86, 0x86, 0x86, 0x86, 0x86, 0x86, 0x86, 0x78,
+  0x78, 0x1E, 0x1E, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61, 0x1E, 0x1E, 0x38, 0x38, 0x00, 0x1C,
+  0x1C, 0x00,
+};
+
+const lcd_font seg7_16 = {
+  16, 0x20, 27, 1, 0,
+  seg7_16_width, seg7_16_bearing, seg7_16_offset, seg7_16_data,
+  0
+};
+
+// seg7 digits: 27 glyphs 0x20..0x3A, height 24, 498 bytes of glyphs, made by digits2lcd.py
+static const uint8_t seg7_24_width[] = {
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 12, 0, 12, 5, 0,
+  15, 3, 15, 12, 15, 15, 15, 12, 15, 15, 5,
+};
+
+static const uint8_t seg7_24_bearing[] = {
+  15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 3, 15, 3, 1, 15,
+  0, 12, 0, 3, 0, 0, 0, 3, 0, 0, 1,
+};
+
+static const uint16_t seg7_24_offset[] = {
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 36, 72, 0,
+  87, 132, 141, 186, 222, 267, 312, 357, 393, 438, 483,
+};
+
+static const uint8_t seg7_24_data[] = {
+  0x00, 0x00, 0x00, 0x80, 0x80, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x3C, 0x3C, 0xFF,
+  0xFF, 0xFF, 0x3C, 0x3C, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x18, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0E, 0x0E, 0x0E, 0x0E, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF0, 0xF8, 0xF0, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E,
+  0x0E, 0x0E, 0x0E, 0xF0, 0xF8, 0xF0, 0xC3, 0xE7, 0xE7, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0xE7, 0xE7, 0xC3, 0x0F, 0x1F, 0x0F, 0x70, 0x70, 0x70, 0x70, 0x70, 0x70, 0x70, 0x70,
+  0x70, 0x0F, 0x1F, 0x0F, 0xF0, 0xF8, 0xF0, 0xE7, 0xE7, 0xC3, 0x0F, 0x1F, 0x0F, 0xF0, 0xF8, 0xF0,
+  0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x00, 0x00, 0x00, 0x03, 0x07, 0x07, 0x18,
+  0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x18, 0xE0, 0xE0, 0xC0, 0x00, 0x00, 0x00, 0x70, 0x70,
+  0x70, 0x70, 0x70, 0x70, 0x70, 0x70, 0x70, 0x0F, 0x1F, 0x0F, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E,
+  0x0E, 0x0E, 0x0E, 0xF0, 0xF8, 0xF0, 0x18, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x18, 0xE7,
+  0xE7, 0xC3, 0x70, 0x70, 0x70, 0x70, 0x70, 0x70, 0x70, 0x70, 0x70, 0x0F, 0x1F, 0x0F, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF0, 0xF8, 0xF0, 0xC0, 0xE0, 0xE0,
+  0x18, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x18, 0xE7, 0xE7, 0xC3, 0x0F, 0x1F, 0x0F, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0F, 0x1F, 0x0F, 0x00, 0x00, 0x00, 0x0E, 0x0E,
+  0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0xF0, 0xF8, 0xF0, 0xC0, 0xE0, 0xE0, 0x18, 0x3C, 0x3C,
+  0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x18, 0x07, 0x07, 0x03, 0x0F, 0x1F, 0x0F, 0x70, 0x70, 0x70, 0x70,
+  0x70, 0x70, 0x70, 0x70, 0x70, 0x00, 0x00, 0x00, 0xF0, 0xF8, 0xF0, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E,
+  0x0E, 0x0E, 0x0E, 0x0E, 0xF0, 0xF8, 0xF0, 0xC3, 0xE7, 0xE7, 0x18, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C,
+  0x3C, 0x3C, 0x18, 0x07, 0x07, 0x03, 0x0F, 0x1F, 0x0F, 0x70, 0x70, 0x70, 0x70, 0x70, 0x70, 0x70,
+  0x70, 0x70, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF0, 0xF8,
+  0xF0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xE7, 0xE7, 0xC3, 0x70, 0x70, 0x70,
+  0x70, 0x70, 0x70, 0x70, 0x70, 0x70, 0x0F, 0x1F, 0x0F, 0xF0, 0xF8, 0xF0, 0x0E, 0x0E, 0x0E, 0x0E,
+  0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0xF0, 0xF8, 0xF0, 0xC3, 0xE7, 0xE7, 0x18, 0x3C, 0x3C, 0x3C, 0x3C,
+  0x3C, 0x3C, 0x3C, 0x18, 0xE7, 0xE7, 0xC3, 0x0F, 0x1F, 0x0F, 0x70, 0x70, 0x70, 0x70, 0x70, 0x70,
+  0x70, 0x70, 0x70, 0x0F, 0x1F, 0x0F, 0x00, 0x00, 0x00, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E,
+  0x0E, 0x0E, 0xF0, 0xF8, 0xF0, 0xC0, 0xE0, 0xE0, 0x18, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C,
+  0x18, 0xE7, 0xE7, 0xC3, 0x0F, 0x1F, 0x0F, 0x70, 0x70, 0x70, 0x70, 0x70, 0x70, 0x70, 0x70, 0x70,
+  0x0F, 0x1F, 0x0F, 0xE0, 0xE0, 0xE0, 0xE0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x07, 0x07, 0x07,
+  0x07, 0x00,
+};
+
+const lcd_font seg7_24 = {
+  24, 0x20, 27, 1, 0,
+  seg7_24_width, seg7_24_bearing, seg7_24_offset, seg7_24_data,
+  0
+};
+
+// seg7 digits: 27 glyphs 0x20..0x3A, height 32, 896 bytes of glyphs, made by digits2lcd.py
+static const uint8_t seg7_32_width[] = {
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 17, 0, 17, 6, 0,
+  20, 4, 20, 17, 20, 20, 20, 17, 20, 20, 6,
+};
+
+static const uint8_t seg7_32_bearing[] = {
+  20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 3, 20, 3, 2, 20,
+  0, 16, 0, 3, 0, 0, 0, 3, 0, 0, 2,
+};
+
+static const uint16_t seg7_32_offset[] = {
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 68, 136, 0,
+  160, 240, 256, 336, 404, 484, 564, 644, 712, 792, 872,
+};
+
+static const uint8_t seg7_32_data[] = {
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x80, 0xC0, 0xC0, 0xC0, 0xC0, 0xFC, 0xFE, 0xFE, 0xFC, 0xC0, 0xC0, 0xC0, 0xC0, 0x80, 0x00,
+  0x00, 0x00, 0x01, 0x03, 0x03, 0x03, 0x03, 0x3F, 0x7F, 0x7F, 0x3F, 0x03, 0x03, 0x03, 0x03, 0x01,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0,
+  0xC0, 0xC0, 0x80, 0x00, 0x00, 0x00, 0x01, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+  0x03, 0x03, 0x03, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3C, 0x3C, 0x3C, 0x3C, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0xC0, 0xE0, 0xE0, 0xD8, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C,
+  0xD8, 0xE0, 0xE0, 0xC0, 0x3F, 0x7F, 0x7F, 0x3F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x3F, 0x7F, 0x7F, 0x3F, 0xFC, 0xFE, 0xFE, 0xFC, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFC, 0xFE, 0xFE, 0xFC, 0x03, 0x07, 0x07, 0x1B,
+  0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x1B, 0x07, 0x07, 0x03,
+  0xC0, 0xE0, 0xE0, 0xC0, 0x3F, 0x7F, 0x7F, 0x3F, 0xFC, 0xFE, 0xFE, 0xFC, 0x03, 0x07, 0x07, 0x03,
+  0xC0, 0xE0, 0xE0, 0xD8, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C,
+  0x18, 0x00, 0x00, 0x00, 0x3F, 0x7F, 0x7F, 0xBF, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0,
+  0xC0, 0xC0, 0xC0, 0xC0, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x03, 0x03, 0x03, 0x03,
+  0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0xFD, 0xFE, 0xFE, 0xFC, 0x00, 0x00, 0x00, 0x18,
+  0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x1B, 0x07, 0x07, 0x03,
+  0x18, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0xD8, 0xE0, 0xE0,
+  0xC0, 0x80, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xBF, 0x7F,
+  0x7F, 0x3F, 0x01, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0xFD,
+  0xFE, 0xFE, 0xFC, 0x18, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C,
+  0x1B, 0x07, 0x07, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0xC0, 0xE0, 0xE0, 0xC0, 0x00, 0x00, 0x00, 0x80, 0xC0, 0xC0, 0xC0, 0xC0,
+  0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xBF, 0x7F, 0x7F, 0x3F, 0xFC, 0xFE, 0xFE, 0xFD,
+  0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0xFD, 0xFE, 0xFE, 0xFC,
+  0x03, 0x07, 0x07, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x03, 0x07, 0x07, 0x03, 0x00, 0x00, 0x00, 0x18, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C,
+  0x3C, 0x3C, 0x3C, 0x3C, 0xD8, 0xE0, 0xE0, 0xC0, 0x00, 0x00, 0x00, 0x80, 0xC0, 0xC0, 0xC0, 0xC0,
+  0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xBF, 0x7F, 0x7F, 0x3F, 0xFC, 0xFE, 0xFE, 0xFD,
+  0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x01, 0x00, 0x00, 0x00,
+  0x03, 0x07, 0x07, 0x1B, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C,
+  0x18, 0x00, 0x00, 0x00, 0xC0, 0xE0, 0xE0, 0xD8, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C,
+  0x3C, 0x3C, 0x3C, 0x3C, 0xD8, 0xE0, 0xE0, 0xC0, 0x3F, 0x7F, 0x7F, 0xBF, 0xC0, 0xC0, 0xC0, 0xC0,
+  0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xBF, 0x7F, 0x7F, 0x3F, 0xFC, 0xFE, 0xFE, 0xFD,
+  0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x01, 0x00, 0x00, 0x00,
+  0x03, 0x07, 0x07, 0x1B, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C,
+  0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0xC0, 0xE0, 0xE0, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x3F, 0x7F, 0x7F, 0x3F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0xFC, 0xFE, 0xFE, 0xFC, 0x18, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C,
+  0x3C, 0x3C, 0x3C, 0x3C, 0x1B, 0x07, 0x07, 0x03, 0xC0, 0xE0, 0xE0, 0xD8, 0x3C, 0x3C, 0x3C, 0x3C,
+  0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0xD8, 0xE0, 0xE0, 0xC0, 0x3F, 0x7F, 0x7F, 0xBF,
+  0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xBF, 0x7F, 0x7F, 0x3F,
+  0xFC, 0xFE, 0xFE, 0xFD, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+  0xFD, 0xFE, 0xFE, 0xFC, 0x03, 0x07, 0x07, 0x1B, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C,
+  0x3C, 0x3C, 0x3C, 0x3C, 0x1B, 0x07, 0x07, 0x03, 0x00, 0x00, 0x00, 0x18, 0x3C, 0x3C, 0x3C, 0x3C,
+  0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0xD8, 0xE0, 0xE0, 0xC0, 0x00, 0x00, 0x00, 0x80,
+  0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xBF, 0x7F, 0x7F, 0x3F,
+  0xFC, 0xFE, 0xFE, 0xFD, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+  0xFD, 0xFE, 0xFE, 0xFC, 0x03, 0x07, 0x07, 0x1B, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C,
+  0x3C, 0x3C, 0x3C, 0x3C, 0x1B, 0x07, 0x07, 0x03, 0x80, 0x80, 0x80, 0x80, 0x00, 0x00, 0x07, 0x07,
+  0x07, 0x07, 0x00, 0x00, 0xE0, 0xE0, 0xE0, 0xE0, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00,
+};
+
+const lcd_font seg7_32 = {
+  32, 0x20, 27, 1, 0,
+  seg7_32_width, seg7_32_bearing, seg7_32_offset, seg7_32_data,
+  0
+};
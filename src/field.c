@@ -0,0 +1,178 @@
+#include "inc/uc1601s.h"
+#include "inc/font.h"
+#include "inc/field.h"
+#include "inc/tools.h"
+
+static uint8_t LCD_field_advance(const lcd_field *fld, char code);
+static void LCD_field_put(const lcd_field *fld, const char *str, uint8_t len, uint16_t pen);
+static void LCD_field_erase(const lcd_field *fld, uint16_t from, uint16_t to);
+
+/**
+ * Prepare an empty text field
+ * @param fld
+ * @param font: proportional font, NULL - chargen[] symbols of type
+ * @param type: FONT_TYPE_5x8, FONT_TYPE_5x15, FONT_TYPE_10x15, FONT_TYPE_10x8 (font NULL)
+ * @param x: left column
+ * @param y: lowest row
+ * @param inverse: INVERSE_TYPE_NOINVERSE, INVERSE_TYPE_INVERSE
+ */
+void LCD_field_init(lcd_field *fld, const lcd_font *font, font_type type, uint8_t x,
+    uint8_t y, inverse_type inverse)
+{
+  fld->font = font;
+  fld->type = type;
+  fld->x = x;
+  fld->y = y;
+  fld->inverse = inverse;
+  fld->advance = LCD_string_width(" ", type) + 1; // chargen[] symbols are of one width
+  fld->shown = 0;
+  fld->text[0] = 0;
+}
+
+/**
+ * Show a string. The symbols that are the same and at the same place as before are not
+ * drawn, every run of changed symbols is drawn in one go, the columns left by a shorter
+ * string are cleared. A counter ticking by one costs a glyph cell.
+ * @param fld
+ * @param str: 0-terminated, codes as in the font
+ */
+void LCD_field_set(lcd_field *fld, const char *str)
+{
+  uint16_t po = 0, pn = 0, run = 0; // pens of the old and the new text, start of a run
+  uint8_t olen = 0, nlen = 0, i, start = 0, changed = 0;
+  char oc, nc;
+
+  if (fld->shown)
+  {
+    while (fld->text[olen])
+      olen++;
+  }
+  while (str[nlen] && (nlen < LCD_FIELD_CHARS))
+    nlen++;
+
+  for (i = 0; (i < olen) || (i < nlen); i++)
+  {
+    oc = (i < olen) ? fld->text[i] : 0;
+    nc = (i < nlen) ? str[i] : 0;
+    if ((oc == nc) && (po == pn))
+    {
+      if (changed)
+        LCD_field_put(fld, str + start, i - start, run);
+      changed = 0;
+    }
+    else if (!changed)
+    {
+      changed = 1;
+      start = i;
+      run = pn;
+    }
+    if (oc)
+      po += LCD_field_advance(fld, oc);
+    if (nc)
+      pn += LCD_field_advance(fld, nc);
+  }
+  if (changed && (nlen > start))
+    LCD_field_put(fld, str + start, nlen - start, run);
+  if (po > pn)
+    LCD_field_erase(fld, pn, po);
+
+  for (i = 0; i < nlen; i++)
+    fld->text[i] = str[i];
+  fld->text[nlen] = 0;
+  fld->shown = 1;
+}
+
+/**
+ * Show an integer (see tool_format_int), only the changed digits are drawn
+ */
+void LCD_field_int(lcd_field *fld, int32_t value, uint8_t width, uint8_t flags)
+{
+  LCD_field_fixed(fld, value, 0, width, flags, 0);
+}
+
+/**
+ * Show a fixed-point number with a unit (see tool_format_fixed), e.g. a readout
+ * LCD_field_fixed(&fld, mV, 3, 6, 0, "V") shows "12.034V"
+ */
+void LCD_field_fixed(lcd_field *fld, int32_t value, uint8_t decimals, uint8_t width,
+    uint8_t flags, const char *unit)
+{
+  char buf[LCD_FIELD_CHARS + 1];
+
+  tool_format_fixed(buf, sizeof(buf), value, decimals, width, flags, unit);
+  LCD_field_set(fld, buf);
+}
+
+/**
+ * Move the field, the text is cleared at the old place and drawn at the new one
+ */
+void LCD_field_move(lcd_field *fld, uint8_t x, uint8_t y)
+{
+  uint16_t pen = 0;
+  uint8_t i;
+
+  if ((fld->x == x) && (fld->y == y))
+    return;
+  if (fld->shown)
+  {
+    for (i = 0; fld->text[i]; i++)
+      pen += LCD_field_advance(fld, fld->text[i]);
+    LCD_field_erase(fld, 0, pen);
+  }
+  fld->x = x;
+  fld->y = y;
+  if (fld->shown)
+  {
+    fld->shown = 0;
+    LCD_field_set(fld, fld->text);
+  }
+}
+
+/**
+ * Forget what the field shows (the screen was cleared), the next string is drawn whole
+ */
+void LCD_field_invalidate(lcd_field *fld)
+{
+  fld->shown = 0;
+}
+
+static uint8_t LCD_field_advance(const lcd_field *fld, char code)
+{
+  const char *s = &code;
+
+  return fld->font ? LCD_glyph_advance(fld->font, &s, 0) : fld->advance;
+}
+
+/**
+ * Draw symbols from pen (columns from the field start)
+ */
+static void LCD_field_put(const lcd_field *fld, const char *str, uint8_t len, uint16_t pen)
+{
+  if (fld->font)
+    LCD_text_part(fld->font, str, len, fld->x + pen, fld->y, fld->inverse, 0);
+  else
+    LCD_string_part(str, len, fld->x + pen, fld->y, fld->type, fld->inverse, 0);
+}
+
+/**
+ * Clear the symbol cells between the pens from and to
+ */
+static void LCD_field_erase(const lcd_field *fld, uint16_t from, uint16_t to)
+{
+  uint8_t spacing;
+
+  if (!fld->font)
+  {
+    // chargen[] cells are cleared the way LCD_symbol() draws them
+    for (; from < to; from += fld->advance)
+      LCD_string_part(" ", 1, fld->x + from, fld->y, fld->type, fld->inverse, 0);
+    return;
+  }
+  // the spacing after the new text is not drawn by LCD_text, the old glyphs may be there
+  spacing = fld->font->spacing;
+  if (from)
+    from -= spacing;
+  if (to - spacing > from)
+    LCD_box(fld->inverse ? FILL_TYPE_BLACK : FILL_TYPE_WHITE, fld->x + from, fld->y,
+        to - spacing - from, fld->font->height);
+}
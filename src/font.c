@@ -0,0 +1,315 @@
+#include "inc/uc1601s.h"
+#include "inc/font.h"
+
+// LCD_text() merges a destination page in chunks of this many columns
+#define TEXT_CHUNK 32
+
+// one page of the composed text line
+static uint8_t textRow[132];
+
+// built-in chargen[] codes of the non-ASCII code points, sorted
+static const lcd_range chargen_range[] = {
+  {0x00A0, 1, 0x20},  // no-break space
+  {0x00B0, 1, 0xBF},  // degree
+  {0x0401, 1, 0xC5},  // Yo as Ye
+  {0x0410, 64, 0xC0}, // A..ya
+  {0x0451, 1, 0xE5},  // yo as ye
+  {0x2080, 9, 0x9D},  // subscript digits 0..8
+  {0x2190, 1, 0xAE},  // arrow left
+  {0x2191, 1, 0xAB},  // arrow up
+  {0x2192, 1, 0xAD},  // arrow right
+  {0x2193, 1, 0xAC},  // arrow down
+  {0x2500, 1, 0xB0},  // box drawings: horizontal
+  {0x2502, 1, 0xB2},  // vertical
+  {0x250C, 1, 0xAF},  // down and right
+  {0x2510, 1, 0xB1},  // down and left
+  {0x2514, 1, 0xB4},  // up and right
+  {0x2518, 1, 0xB5},  // up and left
+  {0x25A0, 1, 0xBC},  // black square
+  {0x25A1, 1, 0xBB},  // white square
+  {0x25B6, 1, 0xB8},  // triangle right
+  {0x25C0, 1, 0xB7},  // triangle left
+  {0x2713, 1, 0xBD},  // check mark
+};
+
+const lcd_cmap chargen_cmap = {chargen_range, sizeof(chargen_range) / sizeof(chargen_range[0])};
+
+static void LCD_text_draw(const lcd_font *font, const char *str, const char *stop, int16_t x,
+    int16_t y, inverse_type inverse, uint8_t utf8);
+static uint16_t LCD_text_advance(const lcd_font *font, const char *str, const char *stop,
+    uint8_t utf8);
+static uint8_t LCD_text_glyph(const lcd_font *font, const char **str, uint8_t utf8);
+static uint8_t LCD_glyph(const lcd_font *font, uint8_t code);
+
+/**
+ * Width of a string in pixels, the spacing after the last glyph is not counted
+ */
+uint16_t LCD_text_width(const lcd_font *font, const char *str)
+{
+  return LCD_text_advance(font, str, 0, 0);
+}
+
+/**
+ * Width of a UTF-8 string in pixels
+ */
+uint16_t LCD_text_width_utf8(const lcd_font *font, const char *str)
+{
+  return LCD_text_advance(font, str, 0, 1);
+}
+
+/**
+ * Print string with a proportional font, the viewport and the clip rectangle apply.
+ * Every destination page is composed from the glyphs first, then read, merged and written
+ * once, so a line of text costs one transaction per page. Pages the text covers whole
+ * (a font of 16, 24, 32 rows at y % 8 == 0) are written without the read.
+ * @param font
+ * @param str: 0-terminated, codes as in the font
+ * @param x: left column
+ * @param y: lowest row of the text, any
+ * @param inverse: INVERSE_TYPE_NOINVERSE, INVERSE_TYPE_INVERSE
+ */
+void LCD_text(const lcd_font *font, const char *str, int16_t x, int16_t y, inverse_type inverse)
+{
+  LCD_text_draw(font, str, 0, x, y, inverse, 0);
+}
+
+/**
+ * Print UTF-8 string with a proportional font (see LCD_text), code points are mapped to the
+ * font codes by font->map while drawing, no transcoded copy is made
+ * @param str: 0-terminated UTF-8, characters out of the font are drawn as font->missing
+ */
+void LCD_text_utf8(const lcd_font *font, const char *str, int16_t x, int16_t y,
+    inverse_type inverse)
+{
+  LCD_text_draw(font, str, 0, x, y, inverse, 1);
+}
+
+/**
+ * Print the first len bytes of a string (see LCD_text), for the text layout
+ * @param utf8: 1 - str is UTF-8 (see LCD_text_utf8)
+ */
+void LCD_text_part(const lcd_font *font, const char *str, uint8_t len, int16_t x, int16_t y,
+    inverse_type inverse, uint8_t utf8)
+{
+  LCD_text_draw(font, str, str + len, x, y, inverse, utf8);
+}
+
+/**
+ * Advance of the next character: bearing, width and spacing
+ * @param str: moved past the character
+ * @param utf8: 1 - str is UTF-8
+ */
+uint8_t LCD_glyph_advance(const lcd_font *font, const char **str, uint8_t utf8)
+{
+  uint8_t g = LCD_text_glyph(font, str, utf8);
+
+  return font->bearing[g] + font->width[g] + font->spacing;
+}
+
+/**
+ * Decode one UTF-8 character and map it to a font code. ASCII is taken as is, other code
+ * points are looked up in the ranges by a binary search.
+ * @param str: moved past the character (one byte for a malformed sequence)
+ * @param map: NULL - code points below 0x100 are the codes (Latin-1)
+ * @return code, 0 - the character is not in the map
+ */
+uint8_t LCD_utf8_next(const char **str, const lcd_cmap *map)
+{
+  const uint8_t *s = (const uint8_t *) *str;
+  uint32_t cp;
+  uint8_t n, i, lo, hi, mid;
+
+  if (s[0] < 0x80)
+  {
+    *str += 1;
+    return s[0];
+  }
+
+  // sequence length and the bits of the lead byte
+  if ((s[0] >= 0xC2) && (s[0] <= 0xDF))
+  {
+    n = 2;
+    cp = s[0] & 0x1F;
+  }
+  else if ((s[0] >= 0xE0) && (s[0] <= 0xEF))
+  {
+    n = 3;
+    cp = s[0] & 0x0F;
+  }
+  else if ((s[0] >= 0xF0) && (s[0] <= 0xF4))
+  {
+    n = 4;
+    cp = s[0] & 0x07;
+  }
+  else
+  {
+    *str += 1;
+    return 0;
+  }
+  // the terminating 0 is never a continuation byte
+  for (i = 1; i < n; i++)
+  {
+    if ((s[i] & 0xC0) != 0x80)
+    {
+      *str += 1;
+      return 0;
+    }
+    cp = (cp << 6) | (s[i] & 0x3F);
+  }
+  *str += n;
+  if (((n == 3) && (cp < 0x800)) || ((n == 4) && (cp < 0x10000)))
+    return 0; // overlong
+
+  if (!map)
+    return (cp < 0x100) ? (uint8_t) cp : 0;
+  if (cp > 0xFFFF)
+    return 0;
+  lo = 0;
+  hi = map->count;
+  while (lo < hi)
+  {
+    mid = (lo + hi) >> 1;
+    if (cp < map->range[mid].first)
+      hi = mid;
+    else if (cp - map->range[mid].first >= map->range[mid].count)
+      lo = mid + 1;
+    else
+      return map->range[mid].code + (uint8_t) (cp - map->range[mid].first);
+  }
+  return 0;
+}
+
+static void LCD_text_draw(const lcd_font *font, const char *str, const char *stop, int16_t x,
+    int16_t y, inverse_type inverse, uint8_t utf8)
+{
+  uint8_t buf[TEXT_CHUNK];
+  uint8_t pages, shift, sp, m, g, gw, n, i, b, first, end;
+  int16_t tx, ty, page, c0, c1, r0, r1, col, pen, gx;
+  uint16_t width;
+  const uint8_t *data;
+  const char *s;
+  lcd_rect clip;
+
+  LCD_clip_get(&clip, &tx, &ty);
+  tx += x;
+  ty += y;
+  width = LCD_text_advance(font, str, stop, utf8);
+  if (!width)
+    return;
+
+  // visible columns c0..c1
+  c0 = (clip.x0 > tx) ? clip.x0 : tx;
+  c1 = (tx + (int16_t) width - 1 > clip.x1) ? clip.x1 : tx + width - 1;
+  if (c0 > c1)
+    return;
+  pages = (font->height + 7) >> 3;
+  shift = ty & 7;
+
+  for (sp = 0; sp <= pages; sp++)
+  {
+    page = (ty >> 3) + sp;
+    if ((page < 0) || (page < (clip.y0 >> 3)))
+      continue;
+    if ((page > 7) || (page > (clip.y1 >> 3)))
+      break;
+
+    // rows of this page covered by the text and the clip rectangle
+    r0 = ((clip.y0 > ty) ? clip.y0 : ty) - page * 8;
+    r1 = ((clip.y1 < ty + font->height - 1) ? clip.y1 : ty + font->height - 1) - page * 8;
+    if ((r0 > 7) || (r1 < 0))
+      continue;
+    m = (0xFF << ((r0 > 0) ? r0 : 0)) & (0xFF >> ((r1 < 7) ? 7 - r1 : 0));
+
+    // glyph columns of this page
+    for (col = c0; col <= c1; col++)
+      textRow[col] = inverse ? 0xFF : 0;
+    pen = tx;
+    s = str;
+    while (*s && (s != stop) && (pen <= c1))
+    {
+      g = LCD_text_glyph(font, &s, utf8);
+      gw = font->width[g];
+      gx = pen + font->bearing[g];
+      data = font->data + font->offset[g];
+      for (i = 0; (i < gw) && (gx + i <= c1); i++)
+      {
+        if (gx + i < c0)
+          continue;
+        b = 0;
+        if (sp < pages)
+          b = data[sp * gw + i] << shift;
+        if (shift && sp)
+          b |= data[(sp - 1) * gw + i] >> (8 - shift);
+        if (inverse)
+          textRow[gx + i] &= ~b;
+        else
+          textRow[gx + i] |= b;
+      }
+      pen = gx + gw + font->spacing;
+    }
+
+    // a page covered by the text (page-aligned fonts) is written straight, nothing to merge
+    if (m == 0xFF)
+    {
+      LCD_page_write(page, c0, &textRow[c0], c1 - c0 + 1);
+      continue;
+    }
+
+    // only the changed part goes back
+    for (col = c0; col <= c1; col += n)
+    {
+      n = (c1 - col + 1 > TEXT_CHUNK) ? TEXT_CHUNK : c1 - col + 1;
+      LCD_page_read(page, col, buf, n);
+      first = n;
+      end = 0;
+      for (i = 0; i < n; i++)
+      {
+        b = (buf[i] & ~m) | (textRow[col + i] & m);
+        if (b != buf[i])
+        {
+          buf[i] = b;
+          if (first == n)
+            first = i;
+          end = i + 1;
+        }
+      }
+      if (first < end)
+        LCD_page_write(page, col + first, &buf[first], end - first);
+    }
+  }
+}
+
+/**
+ * Width of a string up to stop (NULL - the whole string)
+ */
+static uint16_t LCD_text_advance(const lcd_font *font, const char *str, const char *stop,
+    uint8_t utf8)
+{
+  uint16_t width = 0;
+
+  if (!*str || (str == stop))
+    return 0;
+  while (*str && (str != stop))
+    width += LCD_glyph_advance(font, &str, utf8);
+  return width - font->spacing;
+}
+
+/**
+ * Glyph of the next character, str is moved past it
+ */
+static uint8_t LCD_text_glyph(const lcd_font *font, const char **str, uint8_t utf8)
+{
+  uint8_t code;
+
+  if (!utf8 || ((uint8_t) **str < 0x80))
+    return LCD_glyph(font, (uint8_t) *(*str)++);
+  code = LCD_utf8_next(str, font->map);
+  return code ? LCD_glyph(font, code) : font->missing;
+}
+
+static uint8_t LCD_glyph(const lcd_font *font, uint8_t code)
+{
+  if ((code < font->first) || (code - font->first >= font->count))
+    return font->missing;
+  return code - font->first;
+}
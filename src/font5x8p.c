@@ -0,0 +1,117 @@
+// src/uc1601s.c chargen[]: 224 glyphs 0x20..0xFF, height 8, 878 bytes of glyphs, made by bdf2lcd.py
+#include "inc/font.h"
+
+static const uint8_t font5x8p_width[] = {
+  0, 1, 3, 5, 5, 5, 5, 2, 3, 3, 5, 5, 2, 5, 1, 5,
+  5, 3, 5, 5, 5, 5, 5, 5, 5, 5, 2, 2, 4, 5, 4, 5,
+  5, 5, 5, 5, 5, 5, 5, 5, 5, 3, 5, 5, 5, 5, 5, 5,
+  5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 3, 5, 3, 5, 5,
+  2, 5, 5, 5, 5, 5, 5, 5, 5, 3, 4, 4, 3, 5, 5, 5,
+  5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 3, 1, 3, 5, 5,
+  5, 5, 5, 1, 1, 1, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+  5, 5, 3, 3, 3, 5, 5, 5, 5, 5, 5, 5, 5, 3, 1, 3,
+  3, 3, 3, 3, 3, 3, 5, 5, 5, 5, 5, 5, 5, 5, 5, 4,
+  5, 5, 3, 3, 4, 5, 5, 4, 4, 5, 5, 5, 5, 5, 5, 4,
+  5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+  5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+  5, 5, 4, 5, 5, 5, 5, 5, 5, 5, 4, 5, 5, 5, 5, 5,
+  5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 4, 5, 5, 5,
+};
+
+static const uint8_t font5x8p_bearing[] = {
+  2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+};
+
+static const uint16_t font5x8p_offset[] = {
+  0, 0, 1, 4, 9, 14, 19, 24, 26, 29, 32, 37, 42, 44, 49, 50,
+  55, 60, 63, 68, 73, 78, 83, 88, 93, 98, 103, 105, 107, 111, 116, 120,
+  125, 130, 135, 140, 145, 150, 155, 160, 165, 170, 173, 178, 183, 188, 193, 198,
+  203, 208, 213, 218, 223, 228, 233, 238, 243, 248, 253, 258, 261, 266, 269, 274,
+  279, 281, 286, 291, 296, 301, 306, 311, 316, 321, 324, 328, 332, 335, 340, 345,
+  350, 355, 360, 365, 370, 375, 380, 385, 390, 395, 400, 405, 408, 409, 412, 417,
+  422, 427, 432, 437, 437, 437, 438, 44, 443, 448, 438, 44, 443, 448, 453, 458,
+  463, 468, 473, 473, 473, 476, 111, 481, 486, 491, 496, 501, 506, 511, 514, 515,
+  518, 521, 524, 527, 530, 533, 536, 541, 546, 551, 556, 561, 566, 571, 576, 581,
+  111, 585, 473, 473, 590, 594, 599, 604, 608, 612, 617, 622, 627, 632, 637, 642,
+  130, 646, 135, 651, 656, 150, 661, 666, 671, 676, 178, 681, 188, 165, 198, 686,
+  203, 140, 223, 691, 696, 243, 701, 706, 711, 716, 721, 726, 731, 736, 741, 746,
+  281, 751, 756, 760, 765, 301, 770, 775, 780, 785, 790, 794, 799, 804, 345, 809,
+  350, 291, 814, 819, 824, 390, 829, 834, 839, 844, 849, 854, 859, 863, 868, 873,
+};
+
+static const uint8_t font5x8p_data[] = {
+  0xF2, 0xE0, 0x00, 0xE0, 0x28, 0xFE, 0x28, 0xFE, 0x28, 0x24, 0x54, 0xFE, 0x54, 0x48, 0xC6, 0xC8,
+  0x10, 0x26, 0xC6, 0x6C, 0x92, 0xAA, 0x44, 0x0A, 0xA0, 0xC0, 0x38, 0x44, 0x82, 0x82, 0x44, 0x38,
+  0x28, 0x10, 0x7C, 0x10, 0x28, 0x10, 0x10, 0x7C, 0x10, 0x10, 0x0A, 0x0C, 0x10, 0x10, 0x10, 0x10,
+  0x10, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x7C, 0x8A, 0x92, 0xA2, 0x7C, 0x42, 0xFE, 0x02, 0x42,
+  0x86, 0x8A, 0x92, 0x62, 0x84, 0x82, 0xA2, 0xD2, 0x8C, 0x18, 0x28, 0x48, 0xFE, 0x08, 0xE4, 0xA2,
+  0xA2, 0xA2, 0x9C, 0x3C, 0x52, 0x92, 0x92, 0x0C, 0x80, 0x8E, 0x90, 0xA0, 0xC0, 0x6C, 0x92, 0x92,
+  0x92, 0x6C, 0x60, 0x92, 0x92, 0x94, 0x78, 0x6C, 0x6C, 0x6A, 0x6C, 0x10, 0x28, 0x44, 0x82, 0x28,
+  0x28, 0x28, 0x28, 0x28, 0x82, 0x44, 0x28, 0x10, 0x40, 0x80, 0x8A, 0x90, 0x60, 0x4C, 0x92, 0x9C,
+  0x42, 0x3C, 0x7E, 0x88, 0x88, 0x88, 0x7E, 0xFE, 0x92, 0x92, 0x92, 0x6C, 0x7C, 0x82, 0x82, 0x82,
+  0x44, 0xFE, 0x82, 0x82, 0x44, 0x38, 0xFE, 0x92, 0x92, 0x92, 0x82, 0xFE, 0x90, 0x90, 0x90, 0x80,
+  0x7C, 0x82, 0x92, 0x92, 0x5E, 0xFE, 0x10, 0x10, 0x10, 0xFE, 0x82, 0xFE, 0x82, 0x04, 0x02, 0x82,
+  0xFC, 0x80, 0xFE, 0x10, 0x28, 0x44, 0x82, 0xFE, 0x02, 0x02, 0x02, 0x02, 0xFE, 0x40, 0x20, 0x40,
+  0xFE, 0xFE, 0x20, 0x10, 0x08, 0xFE, 0x7C, 0x82, 0x82, 0x82, 0x7C, 0xFE, 0x90, 0x90, 0x90, 0x60,
+  0x7C, 0x82, 0x8A, 0x84, 0x7A, 0xFE, 0x90, 0x98, 0x94, 0x62, 0x62, 0x92, 0x92, 0x92, 0x8C, 0x80,
+  0x80, 0xFE, 0x80, 0x80, 0xFC, 0x02, 0x02, 0x02, 0xFC, 0xF8, 0x04, 0x02, 0x04, 0xF8, 0xFC, 0x02,
+  0x1C, 0x02, 0xFC, 0xC6, 0x28, 0x10, 0x28, 0xC6, 0xE0, 0x10, 0x1E, 0x10, 0xE0, 0x86, 0x8A, 0x92,
+  0xA2, 0xC2, 0xFE, 0x82, 0x82, 0x18, 0x24, 0x7E, 0x24, 0x18, 0x82, 0x82, 0xFE, 0x20, 0x40, 0x80,
+  0x40, 0x20, 0x02, 0x02, 0x02, 0x02, 0x02, 0x80, 0x40, 0x04, 0x2A, 0x2A, 0x2A, 0x1E, 0xFE, 0x12,
+  0x22, 0x22, 0x1C, 0x1C, 0x22, 0x22, 0x22, 0x04, 0x1C, 0x22, 0x22, 0x12, 0xFE, 0x1C, 0x2A, 0x2A,
+  0x2A, 0x18, 0x10, 0x7E, 0x90, 0x80, 0x40, 0x10, 0x2A, 0x2A, 0x2A, 0x3C, 0xFE, 0x10, 0x20, 0x20,
+  0x1E, 0x22, 0xBE, 0x02, 0x04, 0x02, 0x22, 0xBC, 0xFE, 0x08, 0x14, 0x22, 0x82, 0xFE, 0x02, 0x3E,
+  0x20, 0x18, 0x20, 0x1E, 0x3E, 0x10, 0x20, 0x20, 0x1E, 0x1C, 0x22, 0x22, 0x22, 0x1C, 0x3E, 0x28,
+  0x28, 0x28, 0x10, 0x10, 0x28, 0x28, 0x28, 0x3E, 0x3E, 0x10, 0x20, 0x20, 0x10, 0x12, 0x2A, 0x2A,
+  0x2A, 0x24, 0x20, 0xFC, 0x22, 0x02, 0x04, 0x3C, 0x02, 0x02, 0x04, 0x3E, 0x38, 0x04, 0x02, 0x04,
+  0x38, 0x3C, 0x02, 0x0C, 0x02, 0x3C, 0x22, 0x14, 0x08, 0x14, 0x22, 0x30, 0x0A, 0x0A, 0x0A, 0x30,
+  0x22, 0x26, 0x2A, 0x32, 0x22, 0x10, 0x6C, 0x82, 0xFE, 0x82, 0x6C, 0x10, 0x08, 0x10, 0x10, 0x08,
+  0x08, 0xFF, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0xFF, 0x80, 0x80,
+  0x80, 0x80, 0x80, 0x80, 0xFF, 0xFF, 0xFF, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0xFF, 0x10, 0x10,
+  0x10, 0x10, 0x10, 0x10, 0xFF, 0xFF, 0x80, 0xBF, 0xA0, 0xA0, 0xA0, 0xA0, 0xA0, 0xA0, 0xA0, 0xA0,
+  0xBF, 0x80, 0xBF, 0xA0, 0xA0, 0xA0, 0xBF, 0x80, 0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x00, 0xEF, 0x28,
+  0x28, 0x28, 0xEF, 0x00, 0xEF, 0x28, 0x28, 0x28, 0xEF, 0x00, 0xFF, 0xFF, 0x01, 0xFD, 0x05, 0x05,
+  0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0xFD, 0x01, 0xFD, 0x05, 0x05, 0x05, 0xFD, 0x01, 0xFF, 0x3E,
+  0x22, 0x3E, 0x3E, 0x2E, 0x2A, 0x3A, 0x2A, 0x2A, 0x3E, 0x38, 0x08, 0x3E, 0x3A, 0x2A, 0x2E, 0x3E,
+  0x2A, 0x2E, 0x20, 0x20, 0x3E, 0x3E, 0x2A, 0x3E, 0x82, 0xBA, 0xAA, 0x92, 0xBA, 0x8A, 0x8A, 0x82,
+  0xBA, 0x82, 0x88, 0x54, 0x22, 0x88, 0x22, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x10, 0x20, 0x10, 0x10,
+  0x20, 0x20, 0x40, 0xFE, 0x40, 0x20, 0x08, 0x04, 0xFE, 0x04, 0x08, 0x10, 0x10, 0x54, 0x38, 0x10,
+  0x10, 0x38, 0x54, 0x10, 0x10, 0x07, 0x08, 0x13, 0x24, 0x28, 0x28, 0x13, 0x08, 0x07, 0xE0, 0x10,
+  0xC8, 0x24, 0x14, 0x24, 0xC8, 0x10, 0xE0, 0x14, 0x14, 0x14, 0x14, 0x14, 0x10, 0x38, 0x7C, 0xFE,
+  0xFE, 0x7C, 0x38, 0x10, 0x08, 0x78, 0xFC, 0x78, 0x08, 0x63, 0x25, 0x18, 0x18, 0xA4, 0x7E, 0x42,
+  0x42, 0x42, 0x7E, 0x7E, 0x7E, 0x7E, 0x7E, 0x7E, 0x30, 0x0C, 0x30, 0x0C, 0x30, 0x80, 0xFF, 0x01,
+  0x01, 0xFF, 0x60, 0x90, 0x90, 0x60, 0xFE, 0x92, 0x92, 0x92, 0x0C, 0xFE, 0x80, 0x80, 0x80, 0xC0,
+  0x07, 0x8A, 0xF2, 0x82, 0xFF, 0xEE, 0x10, 0xFE, 0x10, 0xEE, 0x92, 0x92, 0x92, 0x92, 0x6C, 0xFE,
+  0x08, 0x10, 0x20, 0xFE, 0x3E, 0x84, 0x48, 0x90, 0x3E, 0x04, 0x82, 0xFC, 0x80, 0xFE, 0xFE, 0x80,
+  0x80, 0x80, 0xFE, 0xE2, 0x14, 0x08, 0x10, 0xE0, 0x18, 0x24, 0xFE, 0x24, 0x18, 0xFE, 0x02, 0x02,
+  0x02, 0xFF, 0xE0, 0x10, 0x10, 0x10, 0xFE, 0xFE, 0x02, 0xFE, 0x02, 0xFE, 0xFE, 0x02, 0xFE, 0x02,
+  0xFF, 0x80, 0xFE, 0x12, 0x12, 0x0C, 0xFE, 0x12, 0x0C, 0x00, 0xFE, 0xFE, 0x12, 0x12, 0x12, 0x0C,
+  0x44, 0x82, 0x92, 0x92, 0x7C, 0xFE, 0x10, 0x7C, 0x82, 0x7C, 0x62, 0x94, 0x98, 0x90, 0xFE, 0x3C,
+  0x52, 0x52, 0x92, 0x8C, 0x3E, 0x2A, 0x2A, 0x14, 0x3E, 0x20, 0x20, 0x20, 0x30, 0x07, 0x2A, 0x32,
+  0x22, 0x3F, 0x36, 0x08, 0x3E, 0x08, 0x36, 0x22, 0x22, 0x2A, 0x2A, 0x14, 0x3E, 0x04, 0x08, 0x10,
+  0x3E, 0x1E, 0x42, 0x24, 0x48, 0x1E, 0x3E, 0x08, 0x14, 0x22, 0x04, 0x22, 0x3C, 0x20, 0x3E, 0x3E,
+  0x10, 0x08, 0x10, 0x3E, 0x3E, 0x08, 0x08, 0x08, 0x3E, 0x3E, 0x20, 0x20, 0x20, 0x3E, 0x20, 0x20,
+  0x3E, 0x20, 0x20, 0x30, 0x0A, 0x0A, 0x0A, 0x3C, 0x38, 0x44, 0xFE, 0x44, 0x38, 0x3E, 0x02, 0x02,
+  0x02, 0x3F, 0x30, 0x08, 0x08, 0x08, 0x3E, 0x3E, 0x02, 0x3E, 0x02, 0x3E, 0x3E, 0x02, 0x3E, 0x02,
+  0x3F, 0x20, 0x3E, 0x0A, 0x0A, 0x04, 0x3E, 0x0A, 0x04, 0x00, 0x3E, 0x3E, 0x0A, 0x0A, 0x04, 0x14,
+  0x22, 0x2A, 0x2A, 0x1C, 0x3E, 0x08, 0x1C, 0x22, 0x1C, 0x10, 0x2A, 0x2C, 0x28, 0x3E,
+};
+
+const lcd_font font5x8p = {
+  8, 0x20, 224, 1, 31,
+  font5x8p_width, font5x8p_bearing, font5x8p_offset, font5x8p_data,
+  &chargen_cmap
+};
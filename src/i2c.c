@@ -1,4 +1,5 @@
 #include "inc/i2c.h"
+#include "inc/tools.h"
 
 //Internal functions
 static uint32_t I2C_Start(void);
@@ -7,6 +8,11 @@ static uint32_t I2C_Write(uint8_t byte);
 static uint32_t I2C_Read(uint8_t *pBuf);
 static uint32_t WaitSR1FlagsSet (uint32_t Flags);
 static uint32_t WaitLineIdle(void);
+static uint32_t I2C_WrBufOnce(uint8_t DataCmd, uint8_t *buf, uint32_t cnt);
+static uint32_t I2C_RdBufOnce(uint8_t DataCmd, uint8_t *buf, uint32_t cnt);
+static uint32_t I2C_RdBufEasyOnce(uint8_t DevAddr, uint8_t *buf, uint32_t cnt);
+static uint32_t I2C_Retry(uint32_t (*xfer)(uint8_t, uint8_t *, uint32_t), uint8_t addr, uint8_t *buf, uint32_t cnt);
+static void I2C_Abort(uint32_t err);
 
 //GPIO and I2C Peripheral
 #define I2Cx                      I2C1  //Selected I2C peripheral
@@ -18,11 +24,25 @@ static uint32_t WaitLineIdle(void);
 #define GPIO_Pin_SCL              GPIO_Pin_6
 #define GPIO_Pin_SDA              GPIO_Pin_7
 
+//Timeouts and retries
+#define I2C_TIMEOUT_US            1000  //Max time to wait for a single flag (one byte at 400kHz takes ~23us)
+#define I2C_RETRIES               3     //Extra attempts for a failed transaction (after bus recovery)
+#define I2C_RECOVERY_CLOCKS       9     //SCL pulses to release a slave that holds SDA low
+#define I2C_ADDR_DATA             0x02  //CD bit of the slave address: GDRAM data, not a command
+
+static uint8_t AddrAcked; //The slave acknowledged the address of the current attempt
+
+static i2c_err_counters ErrCnt;
+static i2c_traffic Traffic;
+
 
 void I2C_LowLevel_Init(void) {
   GPIO_InitTypeDef  GPIO_InitStructure;
   I2C_InitTypeDef   I2C_InitStructure;
 
+  //All the timeouts are measured with the SysTick timebase
+  tool_timebase_init();
+
   //Enable the i2c
   RCC_APB1PeriphClockCmd(RCC_APB1Periph_I2Cx, ENABLE);
   //Reset the Peripheral
@@ -78,30 +98,149 @@ void I2C_LowLevel_DeInit(void) {
   return;
 }
 
+/**
+ * Releases a hung bus and reinitializes the peripheral.
+ * A slave that was interrupted in the middle of a byte may hold SDA low forever.
+ * Clocking SCL by hand lets it finish the byte, then a STOP is generated manually
+ * and the peripheral is reset through I2C_LowLevel_DeInit/I2C_LowLevel_Init.
+ */
+void I2C_BusRecover(void) {
+  GPIO_InitTypeDef  GPIO_InitStructure;
+  uint8_t i;
+
+  ErrCnt.recoveries++;
+
+  I2C_LowLevel_DeInit();
+
+  //Drive the lines as open drain GPIOs. Both are released (high) first
+  GPIO_SetBits(GPIO_SCL, GPIO_Pin_SCL);
+  GPIO_SetBits(GPIO_SDA, GPIO_Pin_SDA);
+  GPIO_InitStructure.GPIO_Pin = GPIO_Pin_SCL;
+  GPIO_InitStructure.GPIO_Mode = GPIO_Mode_Out_OD;
+  GPIO_InitStructure.GPIO_Speed = GPIO_Speed_50MHz;
+  GPIO_Init(GPIO_SCL, &GPIO_InitStructure);
+  GPIO_InitStructure.GPIO_Pin = GPIO_Pin_SDA;
+  GPIO_Init(GPIO_SDA, &GPIO_InitStructure);
+  tool_delay_us(5);
+
+  //Clock out the byte the slave is stuck in (~100kHz)
+  for (i = 0; (i < I2C_RECOVERY_CLOCKS) && !GPIO_ReadInputDataBit(GPIO_SDA, GPIO_Pin_SDA); i++) {
+    GPIO_ResetBits(GPIO_SCL, GPIO_Pin_SCL);
+    tool_delay_us(5);
+    GPIO_SetBits(GPIO_SCL, GPIO_Pin_SCL);
+    tool_delay_us(5);
+  }
+
+  //Stop condition: SDA goes high while SCL is high
+  GPIO_ResetBits(GPIO_SCL, GPIO_Pin_SCL);
+  tool_delay_us(5);
+  GPIO_ResetBits(GPIO_SDA, GPIO_Pin_SDA);
+  tool_delay_us(5);
+  GPIO_SetBits(GPIO_SCL, GPIO_Pin_SCL);
+  tool_delay_us(5);
+  GPIO_SetBits(GPIO_SDA, GPIO_Pin_SDA);
+  tool_delay_us(5);
+
+  //Give the lines back to the peripheral (the peripheral is reset by the init)
+  I2C_LowLevel_Init();
+}
+
+/**
+ * Copies the error counters
+ * @param cnt
+ */
+void I2C_GetErrCounters(i2c_err_counters *cnt) {
+  *cnt = ErrCnt;
+}
+
+/**
+ * Resets the error counters
+ */
+void I2C_ResetErrCounters(void) {
+  ErrCnt.timeouts = 0;
+  ErrCnt.nacks = 0;
+  ErrCnt.bus_errors = 0;
+  ErrCnt.arb_lost = 0;
+  ErrCnt.retries = 0;
+  ErrCnt.recoveries = 0;
+  ErrCnt.failures = 0;
+}
+
+/**
+ * Copies the traffic counters
+ * @param traffic
+ */
+void I2C_GetTraffic(i2c_traffic *traffic) {
+  *traffic = Traffic;
+}
+
+/**
+ * Resets the traffic counters
+ */
+void I2C_ResetTraffic(void) {
+  Traffic.bytes_written = 0;
+  Traffic.bytes_read = 0;
+  Traffic.transactions = 0;
+  Traffic.starts = 0;
+}
+
 /**
  * Writes "cnt" number of bytes from buf
- * @param DevAddr
+ * A failed transaction is retried after a bus recovery. A data transaction is retried only
+ * if its address was not acknowledged: after that the GDRAM address counter of the
+ * controller may have moved, the error is returned and the caller sets the address again.
+ * @param DataCmd
  * @param buf
  * @param cnt
- * @return
+ * @return I2C_ERR_NONE or the error of the last attempt
  */
 uint32_t I2C_WrBuf(uint8_t DataCmd, uint8_t *buf, uint32_t cnt) {
+  return I2C_Retry(I2C_WrBufOnce, DataCmd, buf, cnt);
+}
+
+/**
+ * Reads "cnt" number of bytes to buf (see I2C_RdBufOnce)
+ * @param DataCmd
+ * @param buf
+ * @param cnt
+ * @return I2C_ERR_NONE or the error of the last attempt
+ */
+uint32_t I2C_RdBuf(uint8_t DataCmd, uint8_t *buf, uint32_t cnt) {
+  return I2C_Retry(I2C_RdBufOnce, DataCmd, buf, cnt);
+}
+
+/**
+ * The easy read (see I2C_RdBufEasyOnce)
+ * @param DevAddr
+ * @param buf
+ * @param cnt
+ * @return I2C_ERR_NONE or the error of the last attempt
+ */
+uint32_t I2C_RdBufEasy(uint8_t DevAddr, uint8_t *buf, uint32_t cnt) {
+  return I2C_Retry(I2C_RdBufEasyOnce, DevAddr, buf, cnt);
+}
+
+///////////////TRANSACTIONS/////////////////////
+static uint32_t I2C_WrBufOnce(uint8_t DataCmd, uint8_t *buf, uint32_t cnt) {
+  uint32_t err;
+
   //Generate a Start condition
-  I2C_Start();
+  if ((err = I2C_Start()) != 0) return err;
 
   //Send I2C device Address
 //  I2C_Addr(DevAddr, I2C_Direction_Transmitter);
-	I2C_Addr(0x70|DataCmd, I2C_Direction_Transmitter);
+	if ((err = I2C_Addr(0x70|DataCmd, I2C_Direction_Transmitter)) != 0) return err;
+  AddrAcked = 1;
   //Unstretch the clock by just reading SR2 (Physically the clock is continued to be strectehed because we have not written anything to the DR yet.)
   (void) I2Cx->SR2;
 
   //Start Writing Data
   while (cnt--) {
-    I2C_Write(*buf++);
+    if ((err = I2C_Write(*buf++)) != 0) return err;
   }
 
   //Wait for the data on the shift register to be transmitted completely
-  WaitSR1FlagsSet(I2C_SR1_BTF);
+  if ((err = WaitSR1FlagsSet(I2C_SR1_BTF)) != 0) return err;
   //Here TXE=BTF=1. Therefore the clock stretches again.
 
   //Order a stop condition at the end of the current tranmission (or if the clock is being streched, generate stop immediatelly)
@@ -109,9 +248,7 @@ uint32_t I2C_WrBuf(uint8_t DataCmd, uint8_t *buf, uint32_t cnt) {
   //Stop condition resets the TXE and BTF automatically.
 
   //Wait to be sure that line is iddle
-  WaitLineIdle();
-
-  return 0;
+  return WaitLineIdle();
 }
 
 
@@ -128,17 +265,19 @@ uint32_t I2C_WrBuf(uint8_t DataCmd, uint8_t *buf, uint32_t cnt) {
  * @param cnt
  * @return
  */
-uint32_t I2C_RdBufEasy (uint8_t DevAddr, uint8_t *buf, uint32_t cnt) {
+static uint32_t I2C_RdBufEasyOnce (uint8_t DevAddr, uint8_t *buf, uint32_t cnt) {
+  uint32_t err;
 
   //Generate Start
-  I2C_Start();
+  if ((err = I2C_Start()) != 0) return err;
 
   //Send I2C Device Address and clear ADDR
-  I2C_Addr(DevAddr, I2C_Direction_Receiver);
+  if ((err = I2C_Addr(DevAddr, I2C_Direction_Receiver)) != 0) return err;
+  AddrAcked = 1;
   (void)I2Cx->SR2;
 
   while ((cnt--)>1) {
-    I2C_Read(buf++);
+    if ((err = I2C_Read(buf++)) != 0) return err;
   }
 
   //At this point we assume last byte is being received by the shift register. (reception has not been completed yet)
@@ -149,15 +288,15 @@ uint32_t I2C_RdBufEasy (uint8_t DevAddr, uint8_t *buf, uint32_t cnt) {
   I2Cx->CR1 |= I2C_CR1_STOP;
 
   //Now read the final byte
-  I2C_Read(buf);
+  if ((err = I2C_Read(buf)) != 0) return err;
 
   //Make Sure Stop bit is cleared and Line is now Iddle
-  WaitLineIdle();
+  err = WaitLineIdle();
 
   //Enable the Acknowledgement
   I2Cx->CR1 |= ((uint16_t)I2C_CR1_ACK);
 
-  return 0;
+  return err;
 }
 
 /**
@@ -167,12 +306,15 @@ uint32_t I2C_RdBufEasy (uint8_t DevAddr, uint8_t *buf, uint32_t cnt) {
  * @param cnt
  * @return
  */
-uint32_t I2C_RdBuf (uint8_t DataCmd, uint8_t *buf, uint32_t cnt) {
+static uint32_t I2C_RdBufOnce (uint8_t DataCmd, uint8_t *buf, uint32_t cnt) {
+  uint32_t err;
+
   //Generate Start
-  I2C_Start();
+  if ((err = I2C_Start()) != 0) return err;
 
   //Send I2C Device Address
-  I2C_Addr(0x70|DataCmd, I2C_Direction_Receiver);
+  if ((err = I2C_Addr(0x70|DataCmd, I2C_Direction_Receiver)) != 0) return err;
+  AddrAcked = 1;
 
   if (cnt==1) {//We are going to read only 1 byte
     //Before Clearing Addr bit by reading SR2, we have to cancel ack.
@@ -188,10 +330,10 @@ uint32_t I2C_RdBuf (uint8_t DataCmd, uint8_t *buf, uint32_t cnt) {
     //Be carefull that till the stop condition is actually transmitted the clock will stay active even if a NACK is generated after the next received byte.
 
     //Read the next byte
-    I2C_Read(buf);
+    if ((err = I2C_Read(buf)) != 0) return err;
 
     //Make Sure Stop bit is cleared and Line is now Iddle
-    WaitLineIdle();
+    err = WaitLineIdle();
 
     //Enable the Acknowledgement again
     I2Cx->CR1 |= ((uint16_t)I2C_CR1_ACK);
@@ -206,18 +348,18 @@ uint32_t I2C_RdBuf (uint8_t DataCmd, uint8_t *buf, uint32_t cnt) {
     (void)I2Cx->SR2;
 
     //Wait for the next 2 bytes to be received (1st in the DR, 2nd in the shift register)
-    WaitSR1FlagsSet(I2C_SR1_BTF);
+    if ((err = WaitSR1FlagsSet(I2C_SR1_BTF)) != 0) return err;
     //As we don't read anything from the DR, the clock is now being strecthed.
 
     //Order a stop condition (as the clock is being strecthed, the stop condition is generated immediately)
     I2Cx->CR1 |= I2C_CR1_STOP;
 
     //Read the next two bytes
-    I2C_Read(buf++);
-    I2C_Read(buf);
+    if ((err = I2C_Read(buf++)) != 0) return err;
+    if ((err = I2C_Read(buf)) != 0) return err;
 
     //Make Sure Stop bit is cleared and Line is now Iddle
-    WaitLineIdle();
+    err = WaitLineIdle();
 
     //Enable the ack and reset Pos
     I2Cx->CR1 |= ((uint16_t)I2C_CR1_ACK);
@@ -228,22 +370,22 @@ uint32_t I2C_RdBuf (uint8_t DataCmd, uint8_t *buf, uint32_t cnt) {
     (void)I2Cx->SR2;
 
     while((cnt--)>3) {//Read till the last 3 bytes
-      I2C_Read(buf++);
+      if ((err = I2C_Read(buf++)) != 0) return err;
     }
 
     //3 more bytes to read. Wait till the next to is actually received
-    WaitSR1FlagsSet(I2C_SR1_BTF);
+    if ((err = WaitSR1FlagsSet(I2C_SR1_BTF)) != 0) return err;
     //Here the clock is strecthed. One more to read.
 
     //Reset Ack
     I2Cx->CR1 &= (uint16_t)~((uint16_t)I2C_CR1_ACK);
 
     //Read N-2
-    I2C_Read(buf++);
+    if ((err = I2C_Read(buf++)) != 0) return err;
     //Once we read this, N is going to be read to the shift register and NACK is generated
 
     //Wait for the BTF
-    WaitSR1FlagsSet(I2C_SR1_BTF); //N-1 is in DR, N is in shift register
+    if ((err = WaitSR1FlagsSet(I2C_SR1_BTF)) != 0) return err; //N-1 is in DR, N is in shift register
     //Here the clock is stretched
 
     //Generate a stop condition
@@ -251,17 +393,17 @@ uint32_t I2C_RdBuf (uint8_t DataCmd, uint8_t *buf, uint32_t cnt) {
 
     //Read the last two bytes (N-1 and N)
     //Read the next two bytes
-    I2C_Read(buf++);
-    I2C_Read(buf);
+    if ((err = I2C_Read(buf++)) != 0) return err;
+    if ((err = I2C_Read(buf)) != 0) return err;
 
     //Make Sure Stop bit is cleared and Line is now Iddle
-    WaitLineIdle();
+    err = WaitLineIdle();
 
     //Enable the ack
     I2Cx->CR1 |= ((uint16_t)I2C_CR1_ACK);
   }
 
-  return 0;
+  return err;
 }
 
 ///////////////PRIVATE FUNCTIONS/////////////////////
@@ -273,6 +415,7 @@ static uint32_t I2C_Read(uint8_t *pBuf) {
 
     if (!err) {
       *pBuf = I2Cx->DR;   //This clears the RXNE bit. IF both RXNE and BTF is set, the clock stretches
+      Traffic.bytes_read++;
       return 0;
     }
     else {return err;}
@@ -295,6 +438,7 @@ static uint32_t I2C_Write(uint8_t byte){
 
   //Write the byte to the DR
   I2Cx->DR = byte;
+  Traffic.bytes_written++;
 
   //Wait till the content of DR is transferred to the shift Register.
   return WaitSR1FlagsSet(I2C_SR1_TXE);
@@ -341,6 +485,7 @@ static uint32_t I2C_Start(void) {
 
   //Generate a start condition. (As soon as the line becomes idle, a Start condition will be generated)
   I2Cx->CR1 |= I2C_CR1_START;
+  Traffic.starts++;
 
   //When start condition is generated SB is set and clock is stretched.
   //To activate the clock again i)read SR1 ii)write something to DR (e.g. address)
@@ -360,31 +505,38 @@ static uint32_t I2C_Start(void) {
 static uint32_t WaitSR1FlagsSet (uint32_t Flags) {
   //Wait till the specified SR1 Bits are set
   //More than 1 Flag can be "or"ed. This routine reads only SR1.
-  uint32_t TimeOut = HSI_VALUE;
+  //Bus errors, arbitration loss and NACK abort the wait immediately.
+  uint32_t deadline = tool_deadline_us(I2C_TIMEOUT_US);
+  uint32_t sr1;
 
-  while(((I2Cx->SR1) & Flags) != Flags) {
-    if (!(TimeOut--)) {
-//    	while(1); //todo
-    	//panic(Flags, "I2C Error\n");
-      return 1;
+  while(((sr1 = I2Cx->SR1) & Flags) != Flags) {
+    if (sr1 & I2C_SR1_AF) {
+      return I2C_ERR_NACK;
+    }
+    if (sr1 & I2C_SR1_BERR) {
+      return I2C_ERR_BERR;
+    }
+    if (sr1 & I2C_SR1_ARLO) {
+      return I2C_ERR_ARLO;
+    }
+    if (tool_expired_us(deadline)) {
+      return I2C_ERR_TIMEOUT;
     }
   }
-  return 0;
+  return I2C_ERR_NONE;
 }
 
 
 static uint32_t WaitLineIdle(void) {
   //Wait till the Line becomes idle.
 
-  uint32_t TimeOut = HSI_VALUE;
+  uint32_t deadline = tool_deadline_us(I2C_TIMEOUT_US);
   //Check to see if the Line is busy
   //This bit is set automatically when a start condition is broadcasted on the line (even from another master)
   //and is reset when stop condition is detected.
   while((I2Cx->SR2) & (I2C_SR2_BUSY)) {
-    if (!(TimeOut--)) {
-     // panic(0, "I2C Error\n");
-	while(1); //todo
-    	return 1;
+    if (tool_expired_us(deadline)) {
+      return I2C_ERR_TIMEOUT;
     }
   }
 
@@ -398,7 +550,57 @@ static uint32_t WaitLineIdle(void) {
   }
   */
 
-  return 0;
+  return I2C_ERR_NONE;
+}
+
+
+static uint32_t I2C_Retry(uint32_t (*xfer)(uint8_t, uint8_t *, uint32_t), uint8_t addr, uint8_t *buf, uint32_t cnt) {
+  //Runs the transaction. On failure the bus is brought back to idle and the transaction is repeated
+  //(GDRAM data only while no byte could have moved the address counter)
+  uint32_t err;
+  uint8_t attempt = 0;
+
+  Traffic.transactions++;
+  AddrAcked = 0;
+  while ((err = xfer(addr, buf, cnt)) != I2C_ERR_NONE) {
+    I2C_Abort(err);
+    if ((attempt++ == I2C_RETRIES) || (AddrAcked && (addr & I2C_ADDR_DATA))) {
+      ErrCnt.failures++;
+      break;
+    }
+    ErrCnt.retries++;
+    AddrAcked = 0;
+  }
+  return err;
+}
+
+
+static void I2C_Abort(uint32_t err) {
+  //Counts the error and leaves the bus idle with the peripheral in its default state
+  switch (err) {
+    case I2C_ERR_NACK:
+      ErrCnt.nacks++;
+      //The slave simply did not answer. The bus itself is fine: release it with a stop condition
+      I2Cx->SR1 = (uint16_t)~I2C_SR1_AF;
+      I2Cx->CR1 |= I2C_CR1_STOP;
+      if (WaitLineIdle() == I2C_ERR_NONE) {
+        I2Cx->CR1 &= (uint16_t)~((uint16_t)I2C_CR1_POS);
+        I2Cx->CR1 |= ((uint16_t)I2C_CR1_ACK);
+        return;
+      }
+      break;
+    case I2C_ERR_BERR:
+      ErrCnt.bus_errors++;
+      break;
+    case I2C_ERR_ARLO:
+      ErrCnt.arb_lost++;
+      break;
+    default:
+      ErrCnt.timeouts++;
+      break;
+  }
+
+  I2C_BusRecover();
 }
 
 
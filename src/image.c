@@ -0,0 +1,206 @@
+#include "inc/uc1601s.h"
+#include "inc/image.h"
+
+// LCD_blit() works on a destination page in chunks of this many columns (stack bytes x 2)
+#define BLIT_CHUNK 32
+
+// decoded history for the back references, a page is sent straight from here
+static uint8_t imgWin[256];
+
+/**
+ * Draw a compressed image, the stream is decoded page by page through a fixed window.
+ * Without the framebuffer every page is one I2C data transaction.
+ * @param img
+ * @param x: left column
+ * @param page: lowest page (0-7), the image is clipped at the display edges
+ */
+void LCD_image(const lcd_image *img, uint8_t x, uint8_t page)
+{
+  const uint8_t *src = img->data;
+  const uint8_t *end = img->data + img->size;
+  uint8_t pos = 0; // window index, wraps around
+  uint8_t col = 0, pg = 0, start;
+  uint8_t token, n, b = 0, dist = 0;
+
+  if (!img->width)
+    return;
+
+  while ((src < end) && (pg < img->pages))
+  {
+    token = *src++;
+    if (token < 0x80)
+      n = token + 1;
+    else if (token < 0xC0)
+    {
+      n = (token & 0x3F) + 2;
+      b = *src++;
+    }
+    else
+    {
+      n = (token & 0x3F) + 3;
+      dist = *src++ + 1;
+    }
+
+    while (n--)
+    {
+      if (token < 0x80)
+        b = *src++;
+      else if (token >= 0xC0)
+        b = imgWin[(uint8_t) (pos - dist)];
+      imgWin[pos++] = b;
+
+      if (++col < img->width)
+        continue;
+
+      // a page is complete, it may be split by the window end
+      start = pos - img->width;
+      if ((uint16_t) start + img->width <= sizeof(imgWin))
+        LCD_page_write(page + pg, x, &imgWin[start], img->width);
+      else
+      {
+        LCD_page_write(page + pg, x, &imgWin[start], (uint8_t) (0 - start));
+        if ((uint16_t) x + (uint8_t) (0 - start) < 132)
+          LCD_page_write(page + pg, x + (uint8_t) (0 - start), imgWin,
+              img->width - (uint8_t) (0 - start));
+      }
+      col = 0;
+      if (++pg == img->pages)
+        return;
+    }
+  }
+}
+
+/**
+ * Draw a bitmap with a raster operation, the viewport and the clip rectangle apply
+ * Every destination page is read, merged and written back in chunks. The source
+ * pages are shifted into place when y is not page-aligned. An aligned COPY of whole
+ * pages is written straight from the bitmap.
+ * @param bmp
+ * @param x: left column
+ * @param y: lowest row, any
+ * @param rop: ROP_TYPE_COPY, ROP_TYPE_OR, ROP_TYPE_AND, ROP_TYPE_XOR, ROP_TYPE_ANDNOT
+ */
+void LCD_blit(const lcd_bitmap *bmp, uint8_t x, uint8_t y, rop_type rop)
+{
+  uint8_t src[BLIT_CHUNK], dst[BLIT_CHUNK];
+  uint8_t pages, last_mask, shift, sp, col, n, i, width;
+  uint8_t lo_mask, hi_mask, m, first, end;
+  const uint8_t *lo, *hi;
+  int16_t tx, ty, page, c0, c1, r0, r1;
+  lcd_rect clip;
+
+  LCD_clip_get(&clip, &tx, &ty);
+  tx += x;
+  ty += y;
+  if (!bmp->width || !bmp->height)
+    return;
+
+  // visible columns c0..c1 of the bitmap
+  c0 = (clip.x0 > tx) ? clip.x0 - tx : 0;
+  c1 = (tx + bmp->width - 1 > clip.x1) ? clip.x1 - tx : bmp->width - 1;
+  if (c0 > c1)
+    return;
+  width = c1 - c0 + 1;
+  pages = (bmp->height + 7) >> 3;
+  last_mask = 0xFF >> ((pages << 3) - bmp->height);
+  shift = ty & 7;
+
+  // destination pages touched: ty / 8 .. (ty + height - 1) / 8
+  for (sp = 0; sp <= pages; sp++)
+  {
+    page = (ty >> 3) + sp;
+    if ((page < 0) || (page < (clip.y0 >> 3)))
+      continue;
+    if ((page > 7) || (page > (clip.y1 >> 3)))
+      break;
+
+    // source page landing in the low bits (lo) and the one spilling from above (hi)
+    lo = (sp < pages) ? bmp->data + (uint16_t) sp * bmp->width + c0 : 0;
+    hi = (shift && sp) ? bmp->data + (uint16_t) (sp - 1) * bmp->width + c0 : 0;
+    lo_mask = lo ? ((sp == pages - 1) ? last_mask : 0xFF) << shift : 0;
+    hi_mask = hi ? ((sp == pages) ? last_mask : 0xFF) >> (8 - shift) : 0;
+
+    // rows of this page covered by the bitmap and the clip rectangle
+    r0 = clip.y0 - page * 8;
+    r1 = clip.y1 - page * 8;
+    m = (lo_mask | hi_mask) & (0xFF << ((r0 > 0) ? r0 : 0)) & (0xFF >> ((r1 < 7) ? 7 - r1 : 0));
+    if (!m)
+      continue;
+
+    if ((m == 0xFF) && !shift && (rop == ROP_TYPE_COPY))
+    {
+      LCD_page_write(page, tx + c0, lo, width);
+      continue;
+    }
+
+    for (col = 0; col < width; col += n)
+    {
+      n = (width - col > BLIT_CHUNK) ? BLIT_CHUNK : width - col;
+
+      // source bytes and their coverage in this page
+      if (!shift)
+      {
+        for (i = 0; i < n; i++)
+          src[i] = lo[col + i];
+      }
+      else if (!hi)
+      {
+        for (i = 0; i < n; i++)
+          src[i] = lo[col + i] << shift;
+      }
+      else if (!lo)
+      {
+        for (i = 0; i < n; i++)
+          src[i] = hi[col + i] >> (8 - shift);
+      }
+      else
+      {
+        for (i = 0; i < n; i++)
+          src[i] = (lo[col + i] << shift) | (hi[col + i] >> (8 - shift));
+      }
+      LCD_page_read(page, tx + c0 + col, dst, n);
+
+      // merged result into src
+      switch (rop)
+      {
+        case ROP_TYPE_COPY:
+          for (i = 0; i < n; i++)
+            src[i] = (dst[i] & ~m) | (src[i] & m);
+          break;
+        case ROP_TYPE_OR:
+          for (i = 0; i < n; i++)
+            src[i] = dst[i] | (src[i] & m);
+          break;
+        case ROP_TYPE_AND:
+          for (i = 0; i < n; i++)
+            src[i] = dst[i] & (src[i] | ~m);
+          break;
+        case ROP_TYPE_XOR:
+          for (i = 0; i < n; i++)
+            src[i] = dst[i] ^ (src[i] & m);
+          break;
+        case ROP_TYPE_ANDNOT:
+          for (i = 0; i < n; i++)
+            src[i] = dst[i] & ~(src[i] & m);
+          break;
+        default:
+          return;
+      }
+
+      first = n;
+      end = 0;
+      for (i = 0; i < n; i++)
+      {
+        if (src[i] != dst[i])
+        {
+          if (first == n)
+            first = i;
+          end = i + 1;
+        }
+      }
+      // only the changed part goes back
+      if (first < end)
+        LCD_page_write(page, tx + c0 + col + first, &src[first], end - first);
+    }
+  }
+}
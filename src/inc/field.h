@@ -0,0 +1,32 @@
+#ifndef __FIELD_H
+#define __FIELD_H
+
+#include <stdint.h>
+#include "uc1601s.h"
+#include "font.h"
+
+// symbols kept by a text field, longer strings are cut
+#define LCD_FIELD_CHARS 16
+
+// Text field that remembers what it shows. A new string is compared symbol by symbol
+// and only the changed glyph cells are drawn.
+typedef struct {
+  const lcd_font *font;     // NULL - chargen[] symbols of "type"
+  font_type type;
+  uint8_t x, y;             // left column, the lowest row
+  inverse_type inverse;
+  uint8_t advance;          // of a chargen[] symbol
+  uint8_t shown;            // text is on the screen
+  char text[LCD_FIELD_CHARS + 1];
+} lcd_field;
+
+void LCD_field_init(lcd_field *fld, const lcd_font *font, font_type type, uint8_t x,
+    uint8_t y, inverse_type inverse);
+void LCD_field_set(lcd_field *fld, const char *str);
+void LCD_field_int(lcd_field *fld, int32_t value, uint8_t width, uint8_t flags);
+void LCD_field_fixed(lcd_field *fld, int32_t value, uint8_t decimals, uint8_t width,
+    uint8_t flags, const char *unit);
+void LCD_field_move(lcd_field *fld, uint8_t x, uint8_t y);
+void LCD_field_invalidate(lcd_field *fld);
+
+#endif //__FIELD_H
@@ -0,0 +1,56 @@
+#ifndef __FONT_H
+#define __FONT_H
+
+#include <stdint.h>
+#include "uc1601s.h"
+
+// Unicode code points first..first + count - 1 are font codes code..code + count - 1
+typedef struct {
+  uint16_t first;
+  uint8_t count;
+  uint8_t code;
+} lcd_range;
+
+// Non-ASCII code points of a font, ranges sorted by the first code point
+typedef struct {
+  const lcd_range *range;
+  uint8_t count;
+} lcd_cmap;
+
+// Proportional font in flash (made by scripts/bdf2lcd.py). A glyph is "width" columns of
+// (height + 7) / 8 pages, stored page by page like lcd_bitmap, bit 0 - the lowest row.
+typedef struct {
+  uint8_t height;           // rows
+  uint8_t first;            // code of glyph 0
+  uint8_t count;            // glyphs
+  uint8_t spacing;          // empty columns after every glyph
+  uint8_t missing;          // glyph drawn for the codes out of the font
+  const uint8_t *width;     // columns of every glyph
+  const uint8_t *bearing;   // empty columns before every glyph
+  const uint16_t *offset;   // start of every glyph in data
+  const uint8_t *data;
+  const lcd_cmap *map;      // UTF-8 text, NULL - Latin-1 codes
+} lcd_font;
+
+// code points of the built-in chargen[] (ASCII, pseudographics, Cyrillic)
+extern const lcd_cmap chargen_cmap;
+
+// built-in 5x8 table with the empty columns cut off
+extern const lcd_font font5x8p;
+
+// large digits " +-.0123456789:" (digits.c, made by scripts/digits2lcd.py), 16/24/32 rows:
+// whole pages at y % 8 == 0, digits of one width
+extern const lcd_font digits16, digits24, digits32;
+extern const lcd_font seg7_16, seg7_24, seg7_32;  // 7-segment
+
+uint16_t LCD_text_width(const lcd_font *font, const char *str);
+void LCD_text(const lcd_font *font, const char *str, int16_t x, int16_t y, inverse_type inverse);
+uint16_t LCD_text_width_utf8(const lcd_font *font, const char *str);
+void LCD_text_utf8(const lcd_font *font, const char *str, int16_t x, int16_t y,
+    inverse_type inverse);
+uint8_t LCD_utf8_next(const char **str, const lcd_cmap *map);
+void LCD_text_part(const lcd_font *font, const char *str, uint8_t len, int16_t x, int16_t y,
+    inverse_type inverse, uint8_t utf8);
+uint8_t LCD_glyph_advance(const lcd_font *font, const char **str, uint8_t utf8);
+
+#endif //__FONT_H
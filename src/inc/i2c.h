@@ -3,10 +3,43 @@
 
 #include "stm32f10x.h"
 
+//Transaction results
+typedef enum {
+  I2C_ERR_NONE = 0,
+  I2C_ERR_TIMEOUT = 1,  //A flag or the idle line did not come in time
+  I2C_ERR_NACK = 2,     //Address or data was not acknowledged
+  I2C_ERR_BERR = 3,     //Misplaced start/stop condition on the bus
+  I2C_ERR_ARLO = 4      //Arbitration lost
+} i2c_error;
+
+//Cumulative error counters
+typedef struct {
+  uint32_t timeouts;
+  uint32_t nacks;
+  uint32_t bus_errors;
+  uint32_t arb_lost;
+  uint32_t retries;     //Repeated transactions
+  uint32_t recoveries;  //Bus recoveries (SCL pulses + peripheral reset)
+  uint32_t failures;    //Transactions given up after all the retries
+} i2c_err_counters;
+
+//Cumulative traffic counters
+typedef struct {
+  uint32_t bytes_written; //Payload bytes, the address byte is not counted
+  uint32_t bytes_read;
+  uint32_t transactions;  //Calls of I2C_WrBuf/I2C_RdBuf/I2C_RdBufEasy
+  uint32_t starts;        //START conditions (retries included)
+} i2c_traffic;
+
 void I2C_LowLevel_Init(void);
 void I2C_LowLevel_DeInit(void);
+void I2C_BusRecover(void);
 uint32_t I2C_WrBuf(uint8_t DataCmd, uint8_t *buf, uint32_t cnt);
 uint32_t I2C_RdBuf(uint8_t DevAddr, uint8_t *buf, uint32_t cnt);
 uint32_t I2C_RdBufEasy(uint8_t DevAddr, uint8_t *buf, uint32_t cnt);
+void I2C_GetErrCounters(i2c_err_counters *cnt);
+void I2C_ResetErrCounters(void);
+void I2C_GetTraffic(i2c_traffic *traffic);
+void I2C_ResetTraffic(void);
 
 #endif //__I2C_H
@@ -0,0 +1,41 @@
+#ifndef __IMAGE_H
+#define __IMAGE_H
+
+#include <stdint.h>
+
+// Compressed page-format image (made by scripts/img2lcd.py)
+// The pages are stored one after another, columns left to right,
+// page 0 and bit 0 - the lowest row.
+// The byte stream is compressed with tokens:
+//   0nnnnnnn              - literal, n+1 bytes follow
+//   10nnnnnn b            - byte b repeated n+2 times
+//   11nnnnnn d            - copy n+3 bytes decoded d+1 bytes back (d+1 <= 256)
+// A token may cross the page boundary.
+typedef struct {
+  uint8_t width;        // columns
+  uint8_t pages;        // height / 8
+  uint16_t size;        // compressed stream, bytes
+  const uint8_t *data;
+} lcd_image;
+
+// Uncompressed page-format bitmap: (height + 7) / 8 pages of width bytes,
+// bits below the height in the last page are ignored
+typedef struct {
+  uint8_t width;
+  uint8_t height;       // rows
+  const uint8_t *data;
+} lcd_bitmap;
+
+// raster operations, "src" is a set bitmap pixel
+typedef enum {
+  ROP_TYPE_COPY = 0,    // dst = src
+  ROP_TYPE_OR = 1,      // dst |= src
+  ROP_TYPE_AND = 2,     // dst &= src
+  ROP_TYPE_XOR = 3,     // dst ^= src
+  ROP_TYPE_ANDNOT = 4   // dst &= ~src
+} rop_type;
+
+void LCD_image(const lcd_image *img, uint8_t x, uint8_t page);
+void LCD_blit(const lcd_bitmap *bmp, uint8_t x, uint8_t y, rop_type rop);
+
+#endif //__IMAGE_H
@@ -0,0 +1,16 @@
+#ifndef __LABELS_H
+#define __LABELS_H
+
+#include "image.h"
+
+// Constant text pre-rendered by scripts/labels2lcd.py, drawn with LCD_blit().
+// The build finds LCD_LABEL(name, font, "text") in the sources and makes the
+// bitmap "name", the macro is its address.
+#define LCD_LABEL(name, font, text) (&name)
+
+extern const lcd_bitmap label_hello_10x15;
+extern const lcd_bitmap label_hello_10x8;
+extern const lcd_bitmap label_hello_5x15;
+extern const lcd_bitmap label_hello_5x8;
+
+#endif //__LABELS_H
@@ -0,0 +1,39 @@
+#ifndef __LAYER_H
+#define __LAYER_H
+
+#include <stdint.h>
+
+// layer slots, slot 0 is the bottom
+#define LCD_LAYERS 3
+
+typedef enum {
+  LAYER_MODE_OPAQUE = 0,  // the window replaces what is below
+  LAYER_MODE_OR = 1,      // set pixels are added
+  LAYER_MODE_XOR = 2,     // set pixels invert what is below
+  LAYER_MODE_MASK = 3     // pixels under the set mask bits replace what is below
+} layer_mode;
+
+// 1bpp page-format layer covering a window of the screen
+typedef struct {
+  uint8_t *buf;             // pages * width bytes
+  uint8_t *mask;            // the same size, LAYER_MODE_MASK only
+  uint8_t x, page;          // window position, columns and pages
+  uint8_t width, pages;
+  layer_mode mode;
+  uint8_t visible;
+  uint8_t dirtyMin[8], dirtyMax[8]; // changed screen columns per screen page (min > max - clean)
+} lcd_layer;
+
+void LCD_layer_init(lcd_layer *layer, uint8_t *buf, uint8_t *mask, layer_mode mode,
+    uint8_t x, uint8_t page, uint8_t width, uint8_t pages);
+void LCD_layer_attach(lcd_layer *layer, uint8_t slot);
+void LCD_layer_detach(uint8_t slot);
+void LCD_layer_show(lcd_layer *layer, uint8_t visible);
+void LCD_layer_fill(lcd_layer *layer, uint8_t byte);
+void LCD_layer_pixel(lcd_layer *layer, uint8_t pixel_type, uint8_t x, uint8_t y);
+void LCD_layer_write(lcd_layer *layer, uint8_t page, uint8_t x, const uint8_t *data,
+    uint8_t len);
+void LCD_layer_mark(lcd_layer *layer, uint8_t x, uint8_t page, uint8_t width, uint8_t pages);
+void LCD_compose(void);
+
+#endif //__LAYER_H
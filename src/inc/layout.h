@@ -0,0 +1,49 @@
+#ifndef __LAYOUT_H
+#define __LAYOUT_H
+
+#include <stdint.h>
+#include "uc1601s.h"
+#include "font.h"
+
+// lines of a text box
+#define LCD_LAYOUT_LINES 8
+
+// layout flags
+#define LAYOUT_WRAP     0x01  // break lines between words (otherwise at '\n' only)
+#define LAYOUT_ELLIPSIS 0x02  // a line cut at the box ends with "..."
+#define LAYOUT_UTF8     0x04  // the strings are UTF-8
+
+typedef enum {
+  ALIGN_TYPE_LEFT = 0,
+  ALIGN_TYPE_CENTER = 1,
+  ALIGN_TYPE_RIGHT = 2
+} align_type;
+
+// Text box that keeps the line breaks of the last string. The lines are measured once,
+// a static label is redrawn without measuring.
+typedef struct {
+  const lcd_font *font;     // NULL - chargen[] symbols of "type"
+  font_type type;
+  uint8_t x, y;             // box, y - the lowest row
+  uint8_t width, height;
+  align_type align;
+  uint8_t flags;
+  uint8_t line_height;
+  uint8_t spacing;          // empty columns after every symbol
+  uint8_t advance;          // of a chargen[] symbol
+  uint8_t ellipsis;         // width of "..."
+  const char *str;          // string the lines belong to, NULL - not laid out
+  uint8_t lines;
+  uint8_t cut;              // lines ended with the ellipsis, bit per line
+  uint16_t start[LCD_LAYOUT_LINES];  // first byte of every line in str
+  uint8_t len[LCD_LAYOUT_LINES];     // bytes of every line
+  uint8_t extent[LCD_LAYOUT_LINES];  // width of every line in pixels, the ellipsis included
+} lcd_layout;
+
+void LCD_layout_init(lcd_layout *lay, const lcd_font *font, font_type type, uint8_t x,
+    uint8_t y, uint8_t width, uint8_t height, align_type align, uint8_t flags);
+uint8_t LCD_layout_update(lcd_layout *lay, const char *str);
+void LCD_layout_invalidate(lcd_layout *lay);
+void LCD_layout_draw(lcd_layout *lay, const char *str, inverse_type inverse);
+
+#endif //__LAYOUT_H
@@ -0,0 +1,22 @@
+#ifndef __SHAPES_H
+#define __SHAPES_H
+
+#include <stdint.h>
+#include "uc1601s.h"
+
+// largest radius of the midpoint walk (32-bit decision terms)
+#define LCD_SHAPE_MAX_RADIUS  127
+// most vertices of LCD_polygon()
+#define LCD_POLY_EDGES        16
+
+typedef struct {
+  int16_t x, y;
+} lcd_point;
+
+void LCD_circle(line_type type, fill_type fill, int16_t cx, int16_t cy, uint8_t r);
+void LCD_ellipse(line_type type, fill_type fill, int16_t cx, int16_t cy, uint8_t rx, uint8_t ry);
+void LCD_round_rect(line_type type, fill_type fill, int16_t x, int16_t y, uint8_t width,
+    uint8_t height, uint8_t radius);
+void LCD_polygon(fill_type fill, const lcd_point *pts, uint8_t n);
+
+#endif //__SHAPES_H
@@ -0,0 +1,25 @@
+#ifndef __SPRITE_H
+#define __SPRITE_H
+
+#include <stdint.h>
+#include "image.h"
+
+// RAM for the background under a sprite (two halves, old and new position)
+#define LCD_SPRITE_SAVE_SIZE(width, height)   (2 * (width) * (((height) + 7) / 8 + 1))
+
+// Masked sprite over the background
+typedef struct {
+  const lcd_bitmap *bmp;
+  const lcd_bitmap *mask;   // set bits are drawn (same size as bmp), NULL - the whole box
+  uint8_t *save;            // LCD_SPRITE_SAVE_SIZE(width, height) bytes
+  uint8_t x, y;
+  uint8_t visible;
+  uint8_t half;             // half of "save" holding the current background
+} lcd_sprite;
+
+void LCD_sprite_init(lcd_sprite *spr, const lcd_bitmap *bmp, const lcd_bitmap *mask,
+    uint8_t *save);
+void LCD_sprite_move(lcd_sprite *spr, uint8_t x, uint8_t y);
+void LCD_sprite_hide(lcd_sprite *spr);
+
+#endif //__SPRITE_H
@@ -1,9 +1,29 @@
 #ifndef __TOOLS_H
 #define __TOOLS_H
 
+// SysTick timebase
+void tool_timebase_init(void);
+uint32_t tool_millis(void);
+uint32_t tool_micros(void);
+uint32_t tool_deadline_ms(uint32_t ms);
+uint32_t tool_deadline_us(uint32_t us);
+uint8_t tool_expired_ms(uint32_t deadline);
+uint8_t tool_expired_us(uint32_t deadline);
+void tool_sleep(void);
+
 void tool_delay_ms(uint32_t ms);
+void tool_delay_us(uint32_t us);
 uint8_t tool_strlen(char * str);
 
+// number formatting flags
+#define TOOL_FMT_ZERO 0x01  // pad with zeros after the sign instead of spaces
+#define TOOL_FMT_PLUS 0x02  // '+' before positive numbers
+#define TOOL_FMT_LEFT 0x04  // pad on the right
+
+uint8_t tool_format_int(char *buf, uint8_t size, int32_t value, uint8_t width, uint8_t flags);
+uint8_t tool_format_fixed(char *buf, uint8_t size, int32_t value, uint8_t decimals,
+    uint8_t width, uint8_t flags, const char *unit);
+
 #define TOOL_SET_BIT(var,bitno)   ( (var) |=  (1 << (bitno)) );
 #define TOOL_CLEAR_BIT(var,bitno) ( (var) &= ~(1 << (bitno)) );
 #define TOOL_ABS(a)               ( ( (a) > 0 ) ? (a) : -(a) )
@@ -23,6 +23,31 @@
   #define LCD_HEIGHT 66
 #endif
 
+// shadow framebuffer in RAM (1056 bytes), drawing is sent by LCD_sync()
+// 0 - draw straight to GDRAM (through the readback cache)
+#define LCD_FRAMEBUFFER 1
+
+// keep the picture over an MCU reset (no reset pulse and clear if the controller is still set up)
+// the signature is kept in the 65-th GDRAM row, so a panel that shows it can't have it
+#define LCD_WARM_START (LCD_HEIGHT <= 64)
+
+// write-combining buffer, bytes (1..255)
+#define LCD_WC_SIZE 32
+
+// clip rectangle stack depth
+#define LCD_CLIP_DEPTH 4
+
+// flood fill stack, entries (4 bytes of RAM each, framebuffer only)
+#define LCD_FLOOD_STACK 32
+
+// GDRAM readback cache, entries (power of 2, 0 - no cache). 3 bytes of RAM per entry
+// (not used with the framebuffer)
+#define LCD_GDRAM_CACHE_SIZE 128
+
+// double height chargen[] symbols kept scaled (LRU, 1..254, 0 - no cache),
+// 16 bytes of RAM per entry
+#define LCD_GLYPH_CACHE_SIZE 32
+
 typedef enum {
   INVERSE_TYPE_NOINVERSE = 0,
   INVERSE_TYPE_INVERSE = 1
@@ -47,6 +72,14 @@ typedef enum {
   FILL_TYPE_SEA = 4
 } fill_type;
 
+// line pen, the pattern repeats every "length" pixels along the major axis
+typedef struct {
+  uint8_t color;            // 0 - white, 1 - black
+  uint8_t width;            // pixels across the line
+  uint8_t length;           // pattern length: 8, 16 or 32
+  uint32_t pattern;         // bit n - pixel n is drawn, 0xFFFFFFFF - solid
+} lcd_pen;
+
 typedef enum  {
   FONT_TYPE_5x8,
   FONT_TYPE_5x15,
@@ -54,17 +87,75 @@ typedef enum  {
   FONT_TYPE_10x8,
 } font_type;
 
+// rectangle, inclusive corners
+typedef struct {
+  int16_t x0, y0;
+  int16_t x1, y1;
+} lcd_rect;
+
+// driver statistics (see LCD_stats)
+typedef struct {
+  uint32_t bytes_written;     // I2C payload bytes
+  uint32_t bytes_read;
+  uint32_t transactions;      // I2C transactions
+  uint32_t starts;            // START conditions, retries included
+  uint32_t timeouts;
+  uint32_t retries;
+  uint32_t cache_hits;        // GDRAM reads served by the readback cache
+  uint32_t cache_misses;
+  uint32_t glyph_hits;        // double height symbols served by the glyph cache
+  uint32_t glyph_misses;
+  uint32_t flushes;           // screen updates pushed to GDRAM
+  uint32_t dirty_bytes;       // GDRAM bytes sent by all flushes
+  uint32_t dirty_bytes_avg;   // per flush
+  uint32_t flush_us_max;
+  uint32_t flush_us_avg;
+} lcd_stats;
+
 void LCD_init (void);
+void LCD_init_start(const uint8_t *splash);
+uint8_t LCD_init_step(void);
+uint8_t LCD_ready(void);
 void LCD_fill(uint8_t type);
 void LCD_clear(void);
+void LCD_sync(void);
 void LCD_cursor(uint8_t x,uint8_t y);
 void LCD_symbol(char code, uint8_t width, uint8_t height, inverse_type inverse);
 void LCD_string(char *str, uint8_t x,  uint8_t y, font_type font, inverse_type inverse);
+void LCD_string_utf8(const char *str, uint8_t x, uint8_t y, font_type font,
+    inverse_type inverse);
+void LCD_string_part(const char *str, uint8_t len, int16_t x, int16_t y, font_type font,
+    inverse_type inverse, uint8_t utf8);
+uint16_t LCD_string_width(const char *str, font_type font);
+uint16_t LCD_string_width_utf8(const char *str, font_type font);
+uint8_t LCD_string_height(font_type font);
+
+// GDRAM page access
+void LCD_page_write(uint8_t page, uint8_t x, const uint8_t *data, uint8_t len);
+void LCD_page_read(uint8_t page, uint8_t x, uint8_t *data, uint8_t len);
+
+// clipping and viewport (used by the primitives, not by the page access)
+void LCD_viewport(int16_t x, int16_t y);
+uint8_t LCD_clip_push(int16_t x, int16_t y, uint8_t width, uint8_t height);
+void LCD_clip_pop(void);
+void LCD_clip_reset(void);
+void LCD_clip_get(lcd_rect *rect, int16_t *x, int16_t *y);
 
 // primitives
 void LCD_pixel(uint8_t pixel_type, uint8_t x, uint8_t y);
 void LCD_line(line_type line_type, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1);
+void LCD_line_pen(const lcd_pen *pen, int16_t x0, int16_t y0, int16_t x1, int16_t y1);
 void LCD_rect(line_type frame_type, angle_type ang_type, uint8_t border_width,
     fill_type fill, uint8_t x0, uint8_t y0, uint8_t width, uint8_t height);
+void LCD_box(fill_type fill, int16_t x, int16_t y, uint8_t width, uint8_t height);
+void LCD_hspan(fill_type fill, int16_t x0, int16_t x1, int16_t y);
+void LCD_vspan(fill_type fill, int16_t x, int16_t y0, int16_t y1);
+#if LCD_FRAMEBUFFER
+uint8_t LCD_flood(uint8_t pixel_type, int16_t x, int16_t y);
+#endif
+
+// instrumentation
+void LCD_stats(lcd_stats *stats);
+void LCD_stats_reset(void);
 
 #endif //__UC1601S_H
@@ -0,0 +1,62 @@
+// 4 labels of the sources, made by labels2lcd.py
+#include "inc/labels.h"
+
+// FONT_TYPE_10x15 Hello world!
+static const uint8_t label_hello_10x15_data[] = {
+  0xFC, 0xFC, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFC, 0xFC, 0x00, 0xF0, 0xF0, 0xCC, 0xCC, 0xCC,
+  0xCC, 0xCC, 0xCC, 0xC0, 0xC0, 0x00, 0x00, 0x00, 0x0C, 0x0C, 0xFC, 0xFC, 0x0C, 0x0C, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x0C, 0x0C, 0xFC, 0xFC, 0x0C, 0x0C, 0x00, 0x00, 0x00, 0xF0, 0xF0, 0x0C, 0x0C,
+  0x0C, 0x0C, 0x0C, 0x0C, 0xF0, 0xF0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0xF0, 0xF0, 0x0C, 0x0C, 0xF0, 0xF0, 0x0C, 0x0C, 0xF0, 0xF0, 0x00, 0xF0, 0xF0, 0x0C,
+  0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0xF0, 0xF0, 0x00, 0xFC, 0xFC, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C, 0xFC, 0xFC, 0x0C, 0x0C, 0x00, 0x00, 0x00, 0xF0, 0xF0,
+  0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0xFC, 0xFC, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0xFF, 0xFF, 0x00, 0x03,
+  0x03, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x03, 0x03, 0x00, 0x00, 0x00, 0xC0, 0xC0, 0xFF, 0xFF,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0xC0, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x03, 0x03, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x03, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0F, 0x0F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0F, 0x0F,
+  0x00, 0x03, 0x03, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x03, 0x03, 0x00, 0x0F, 0x0F, 0x03, 0x03,
+  0x0C, 0x0C, 0x0C, 0x0C, 0x03, 0x03, 0x00, 0x00, 0x00, 0xC0, 0xC0, 0xFF, 0xFF, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x03, 0x03, 0x0C, 0x0C, 0x0C, 0x0C, 0x03, 0x03, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+const lcd_bitmap label_hello_10x15 = {132, 16, label_hello_10x15_data};
+
+// FONT_TYPE_10x8 Hello world!
+static const uint8_t label_hello_10x8_data[] = {
+  0xFE, 0xFE, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0xFE, 0xFE, 0x00, 0x1C, 0x1C, 0x2A, 0x2A, 0x2A,
+  0x2A, 0x2A, 0x2A, 0x18, 0x18, 0x00, 0x00, 0x00, 0x82, 0x82, 0xFE, 0xFE, 0x02, 0x02, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x82, 0x82, 0xFE, 0xFE, 0x02, 0x02, 0x00, 0x00, 0x00, 0x1C, 0x1C, 0x22, 0x22,
+  0x22, 0x22, 0x22, 0x22, 0x1C, 0x1C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x3C, 0x3C, 0x02, 0x02, 0x0C, 0x0C, 0x02, 0x02, 0x3C, 0x3C, 0x00, 0x1C, 0x1C, 0x22,
+  0x22, 0x22, 0x22, 0x22, 0x22, 0x1C, 0x1C, 0x00, 0x3E, 0x3E, 0x10, 0x10, 0x20, 0x20, 0x20, 0x20,
+  0x10, 0x10, 0x00, 0x00, 0x00, 0x82, 0x82, 0xFE, 0xFE, 0x02, 0x02, 0x00, 0x00, 0x00, 0x1C, 0x1C,
+  0x22, 0x22, 0x22, 0x22, 0x12, 0x12, 0xFE, 0xFE, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF2, 0xF2, 0x00,
+  0x00, 0x00, 0x00, 0x00,
+};
+const lcd_bitmap label_hello_10x8 = {132, 8, label_hello_10x8_data};
+
+// FONT_TYPE_5x15 Hello world!
+static const uint8_t label_hello_5x15_data[] = {
+  0xFC, 0x00, 0x00, 0x00, 0xFC, 0x00, 0xF0, 0xCC, 0xCC, 0xCC, 0xC0, 0x00, 0x00, 0x0C, 0xFC, 0x0C,
+  0x00, 0x00, 0x00, 0x0C, 0xFC, 0x0C, 0x00, 0x00, 0xF0, 0x0C, 0x0C, 0x0C, 0xF0, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0xF0, 0x0C, 0xF0, 0x0C, 0xF0, 0x00, 0xF0, 0x0C, 0x0C, 0x0C, 0xF0, 0x00,
+  0xFC, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0xFC, 0x0C, 0x00, 0x00, 0xF0, 0x0C, 0x0C, 0x0C,
+  0xFC, 0x00, 0x00, 0x00, 0x0C, 0x00, 0x00, 0x00, 0xFF, 0x03, 0x03, 0x03, 0xFF, 0x00, 0x03, 0x0C,
+  0x0C, 0x0C, 0x03, 0x00, 0x00, 0xC0, 0xFF, 0x00, 0x00, 0x00, 0x00, 0xC0, 0xFF, 0x00, 0x00, 0x00,
+  0x03, 0x0C, 0x0C, 0x0C, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0F, 0x00, 0x00, 0x00,
+  0x0F, 0x00, 0x03, 0x0C, 0x0C, 0x0C, 0x03, 0x00, 0x0F, 0x03, 0x0C, 0x0C, 0x03, 0x00, 0x00, 0xC0,
+  0xFF, 0x00, 0x00, 0x00, 0x03, 0x0C, 0x0C, 0x03, 0xFF, 0x00, 0x00, 0x00, 0xFF, 0x00, 0x00, 0x00,
+};
+const lcd_bitmap label_hello_5x15 = {72, 16, label_hello_5x15_data};
+
+// FONT_TYPE_5x8 Hello world!
+static const uint8_t label_hello_5x8_data[] = {
+  0xFE, 0x10, 0x10, 0x10, 0xFE, 0x00, 0x1C, 0x2A, 0x2A, 0x2A, 0x18, 0x00, 0x00, 0x82, 0xFE, 0x02,
+  0x00, 0x00, 0x00, 0x82, 0xFE, 0x02, 0x00, 0x00, 0x1C, 0x22, 0x22, 0x22, 0x1C, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x3C, 0x02, 0x0C, 0x02, 0x3C, 0x00, 0x1C, 0x22, 0x22, 0x22, 0x1C, 0x00,
+  0x3E, 0x10, 0x20, 0x20, 0x10, 0x00, 0x00, 0x82, 0xFE, 0x02, 0x00, 0x00, 0x1C, 0x22, 0x22, 0x12,
+  0xFE, 0x00, 0x00, 0x00, 0xF2, 0x00, 0x00, 0x00,
+};
+const lcd_bitmap label_hello_5x8 = {72, 8, label_hello_5x8_data};
@@ -0,0 +1,256 @@
+#include "inc/uc1601s.h"
+#include "inc/layer.h"
+#include "inc/tools.h"
+
+static lcd_layer *layers[LCD_LAYERS];
+
+// screen area uncovered by detached layers
+static uint8_t compDirtyMin[8] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+static uint8_t compDirtyMax[8];
+
+// one composed page span
+static uint8_t compRow[132];
+
+static void LCD_span_add(uint8_t *min, uint8_t *max, uint8_t c0, uint8_t c1);
+
+/**
+ * Prepare a hidden, detached layer. Coordinates of the drawing functions are relative
+ * to the layer window.
+ * @param layer
+ * @param buf: pages * width bytes
+ * @param mask: pages * width bytes for LAYER_MODE_MASK, NULL otherwise
+ * @param mode: LAYER_MODE_OPAQUE, LAYER_MODE_OR, LAYER_MODE_XOR, LAYER_MODE_MASK
+ * @param x: window left column
+ * @param page: window top page
+ * @param width
+ * @param pages
+ */
+void LCD_layer_init(lcd_layer *layer, uint8_t *buf, uint8_t *mask, layer_mode mode,
+    uint8_t x, uint8_t page, uint8_t width, uint8_t pages)
+{
+  uint8_t j;
+
+  layer->buf = buf;
+  layer->mask = mask;
+  layer->mode = mode;
+  layer->x = x;
+  layer->page = page;
+  layer->width = width;
+  layer->pages = pages;
+  layer->visible = 0;
+  for (j = 0; j < 8; j++)
+  {
+    layer->dirtyMin[j] = 0xFF;
+    layer->dirtyMax[j] = 0;
+  }
+}
+
+/**
+ * Put a layer into a slot (a higher slot is drawn over a lower one)
+ * The layer replaces the one attached to the slot before.
+ */
+void LCD_layer_attach(lcd_layer *layer, uint8_t slot)
+{
+  if (slot >= LCD_LAYERS)
+    return;
+  LCD_layer_detach(slot);
+  layers[slot] = layer;
+  LCD_layer_mark(layer, 0, 0, layer->width, layer->pages);
+}
+
+/**
+ * Take a layer out of the composition, its window is recomposed from the rest
+ */
+void LCD_layer_detach(uint8_t slot)
+{
+  lcd_layer *layer;
+  uint16_t c1;
+  uint8_t page;
+
+  if ((slot >= LCD_LAYERS) || !layers[slot])
+    return;
+  layer = layers[slot];
+  layers[slot] = 0;
+  if (!layer->visible || !layer->width || (layer->x > 131))
+    return;
+  c1 = (uint16_t) layer->x + layer->width - 1;
+  if (c1 > 131)
+    c1 = 131;
+  for (page = layer->page; (page < 8) && (page < layer->page + layer->pages); page++)
+    LCD_span_add(&compDirtyMin[page], &compDirtyMax[page], layer->x, c1);
+}
+
+/**
+ * Show or hide a layer (e.g. dismiss a popup), the layers below are not redrawn
+ * by the application
+ */
+void LCD_layer_show(lcd_layer *layer, uint8_t visible)
+{
+  if (layer->visible == visible)
+    return;
+  layer->visible = visible;
+  LCD_layer_mark(layer, 0, 0, layer->width, layer->pages);
+}
+
+/**
+ * Fill the whole layer
+ */
+void LCD_layer_fill(lcd_layer *layer, uint8_t byte)
+{
+  uint16_t j;
+
+  for (j = 0; j < (uint16_t) layer->width * layer->pages; j++)
+    layer->buf[j] = byte;
+  LCD_layer_mark(layer, 0, 0, layer->width, layer->pages);
+}
+
+/**
+ * Plot pixel on a layer
+ * @param pixel_type 0 - white, 1 - black
+ * @param x, y: inside the window
+ */
+void LCD_layer_pixel(lcd_layer *layer, uint8_t pixel_type, uint8_t x, uint8_t y)
+{
+  uint8_t *byte;
+
+  if ((x >= layer->width) || ((y >> 3) >= layer->pages))
+    return;
+  byte = &layer->buf[(uint16_t) (y >> 3) * layer->width + x];
+  if (pixel_type)
+  {
+    TOOL_SET_BIT(*byte, y & 7);
+  }
+  else
+  {
+    TOOL_CLEAR_BIT(*byte, y & 7);
+  }
+  LCD_layer_mark(layer, x, y >> 3, 1, 1);
+}
+
+/**
+ * Write a run of bytes into one page of a layer (like LCD_page_write)
+ * @param page, x: inside the window
+ */
+void LCD_layer_write(lcd_layer *layer, uint8_t page, uint8_t x, const uint8_t *data,
+    uint8_t len)
+{
+  uint8_t *dst;
+  uint8_t j;
+
+  if ((page >= layer->pages) || (x >= layer->width))
+    return;
+  if (len > layer->width - x)
+    len = layer->width - x;
+  dst = &layer->buf[(uint16_t) page * layer->width + x];
+  for (j = 0; j < len; j++)
+    dst[j] = data[j];
+  LCD_layer_mark(layer, x, page, len, 1);
+}
+
+/**
+ * Mark a part of the layer changed (after writing layer->buf directly)
+ * @param x, page: inside the window
+ * @param width
+ * @param pages
+ */
+void LCD_layer_mark(lcd_layer *layer, uint8_t x, uint8_t page, uint8_t width, uint8_t pages)
+{
+  uint16_t c0, c1;
+  uint8_t p;
+
+  if (!width || (x >= layer->width))
+    return;
+  if (width > layer->width - x)
+    width = layer->width - x;
+  c0 = layer->x + x;
+  c1 = c0 + width - 1;
+  if (c0 > 131)
+    return;
+  if (c1 > 131)
+    c1 = 131;
+  for (p = layer->page + page; pages-- && (p < 8) && (p < layer->page + layer->pages); p++)
+    LCD_span_add(&layer->dirtyMin[p], &layer->dirtyMax[p], c0, c1);
+}
+
+/**
+ * Recompose the dirty spans of all layers and write them to the display
+ * (to the framebuffer, LCD_sync() sends it). White is below the bottom layer.
+ */
+void LCD_compose(void)
+{
+  lcd_layer *layer;
+  uint8_t page, min, max, slot, col, c0, c1;
+  const uint8_t *src, *msk;
+
+  for (page = 0; page < 8; page++)
+  {
+    // union of the dirty spans on this page
+    min = compDirtyMin[page];
+    max = compDirtyMax[page];
+    for (slot = 0; slot < LCD_LAYERS; slot++)
+    {
+      layer = layers[slot];
+      if (!layer || (layer->dirtyMin[page] > layer->dirtyMax[page]))
+        continue;
+      if (layer->dirtyMin[page] < min)
+        min = layer->dirtyMin[page];
+      if (layer->dirtyMax[page] > max)
+        max = layer->dirtyMax[page];
+      layer->dirtyMin[page] = 0xFF;
+      layer->dirtyMax[page] = 0;
+    }
+    compDirtyMin[page] = 0xFF;
+    compDirtyMax[page] = 0;
+    if (min > max)
+      continue;
+
+    for (col = min; col <= max; col++)
+      compRow[col] = 0;
+
+    // bottom to top, each layer over its part of the span
+    for (slot = 0; slot < LCD_LAYERS; slot++)
+    {
+      layer = layers[slot];
+      if (!layer || !layer->visible || (page < layer->page)
+          || (page >= layer->page + layer->pages))
+        continue;
+      c0 = (layer->x > min) ? layer->x : min;
+      c1 = ((uint16_t) layer->x + layer->width - 1 < max) ? layer->x + layer->width - 1 : max;
+      if (c0 > c1)
+        continue;
+      src = &layer->buf[(uint16_t) (page - layer->page) * layer->width + c0 - layer->x];
+      switch (layer->mode)
+      {
+        case LAYER_MODE_OPAQUE:
+          for (col = c0; col <= c1; col++)
+            compRow[col] = *src++;
+          break;
+        case LAYER_MODE_OR:
+          for (col = c0; col <= c1; col++)
+            compRow[col] |= *src++;
+          break;
+        case LAYER_MODE_XOR:
+          for (col = c0; col <= c1; col++)
+            compRow[col] ^= *src++;
+          break;
+        case LAYER_MODE_MASK:
+          msk = &layer->mask[src - layer->buf];
+          for (col = c0; col <= c1; col++, msk++)
+            compRow[col] = (compRow[col] & ~*msk) | (*src++ & *msk);
+          break;
+        default:
+          break;
+      }
+    }
+
+    LCD_page_write(page, min, &compRow[min], max - min + 1);
+  }
+}
+
+static void LCD_span_add(uint8_t *min, uint8_t *max, uint8_t c0, uint8_t c1)
+{
+  if (c0 < *min)
+    *min = c0;
+  if (c1 > *max)
+    *max = c1;
+}
@@ -0,0 +1,239 @@
+#include "inc/uc1601s.h"
+#include "inc/font.h"
+#include "inc/layout.h"
+
+static void LCD_layout_break(lcd_layout *lay, const char *str);
+static void LCD_layout_ellipsis(lcd_layout *lay, const char *str, uint8_t line);
+static uint8_t LCD_layout_advance(const lcd_layout *lay, const char **str);
+static void LCD_layout_put(const lcd_layout *lay, const char *str, uint8_t len, int16_t x,
+    int16_t y, inverse_type inverse);
+
+/**
+ * Prepare a text box
+ * @param lay
+ * @param font: proportional font, NULL - chargen[] symbols of type
+ * @param type: FONT_TYPE_5x8, FONT_TYPE_5x15, FONT_TYPE_10x15, FONT_TYPE_10x8 (font NULL)
+ * @param x, y: left column and the lowest row of the box
+ * @param width, height
+ * @param align: ALIGN_TYPE_LEFT, ALIGN_TYPE_CENTER, ALIGN_TYPE_RIGHT
+ * @param flags: LAYOUT_WRAP, LAYOUT_ELLIPSIS, LAYOUT_UTF8
+ */
+void LCD_layout_init(lcd_layout *lay, const lcd_font *font, font_type type, uint8_t x,
+    uint8_t y, uint8_t width, uint8_t height, align_type align, uint8_t flags)
+{
+  const char *dots = "...";
+
+  lay->font = font;
+  lay->type = type;
+  lay->x = x;
+  lay->y = y;
+  lay->width = width;
+  lay->height = height;
+  lay->align = align;
+  lay->flags = flags;
+  lay->line_height = font ? font->height : LCD_string_height(type);
+  lay->spacing = font ? font->spacing : 1;
+  lay->advance = LCD_string_width(" ", type) + 1; // chargen[] symbols are of one width
+  lay->ellipsis = 0;
+  while (*dots)
+    lay->ellipsis += LCD_layout_advance(lay, &dots);
+  lay->ellipsis -= lay->spacing;
+  lay->str = 0;
+  lay->lines = 0;
+  lay->cut = 0;
+}
+
+/**
+ * Break a string into the lines of the box, nothing is done for the string laid out last
+ * @return lines
+ */
+uint8_t LCD_layout_update(lcd_layout *lay, const char *str)
+{
+  if (str != lay->str)
+  {
+    LCD_layout_break(lay, str);
+    lay->str = str;
+  }
+  return lay->lines;
+}
+
+/**
+ * Forget the line breaks (the string was changed in place)
+ */
+void LCD_layout_invalidate(lcd_layout *lay)
+{
+  lay->str = 0;
+}
+
+/**
+ * Print a string in the box, the lines are clipped at the box
+ * @param lay
+ * @param str: 0-terminated, '\n' starts a new line
+ * @param inverse: INVERSE_TYPE_NOINVERSE, INVERSE_TYPE_INVERSE
+ */
+void LCD_layout_draw(lcd_layout *lay, const char *str, inverse_type inverse)
+{
+  uint8_t line, clipped, left;
+  int16_t x, y;
+
+  LCD_layout_update(lay, str);
+  clipped = LCD_clip_push(lay->x, lay->y, lay->width, lay->height);
+  for (line = 0; line < lay->lines; line++)
+  {
+    left = (lay->extent[line] < lay->width) ? lay->width - lay->extent[line] : 0;
+    if (lay->align == ALIGN_TYPE_CENTER)
+      left >>= 1;
+    else if (lay->align != ALIGN_TYPE_RIGHT)
+      left = 0;
+    x = lay->x + left;
+    y = lay->y + lay->height - (line + 1) * lay->line_height;
+    LCD_layout_put(lay, str + lay->start[line], lay->len[line], x, y, inverse);
+    if (lay->cut & (1 << line))
+      LCD_layout_put(lay, "...", 3, x + lay->extent[line] - lay->ellipsis, y, inverse);
+  }
+  if (clipped)
+    LCD_clip_pop();
+}
+
+/**
+ * Greedy line breaking: a line ends at '\n', or (LAYOUT_WRAP) at the last space that
+ * fits, or inside a word wider than the box. The text left below the box is cut.
+ */
+static void LCD_layout_break(lcd_layout *lay, const char *str)
+{
+  const char *s = str, *line, *c, *brk, *end;
+  uint16_t w, brk_w, a;
+  uint8_t n, max, cut;
+
+  max = lay->height / lay->line_height;
+  if (max > LCD_LAYOUT_LINES)
+    max = LCD_LAYOUT_LINES;
+  lay->cut = 0;
+
+  for (n = 0; (n < max) && *s; n++)
+  {
+    line = s;
+    brk = 0;
+    brk_w = 0;
+    w = 0; // advances so far, the spacing after the last symbol included
+    cut = 0;
+    end = 0;
+    while (*s && (*s != '\n'))
+    {
+      c = s;
+      // a line may end before a space that follows a word
+      if ((*c == ' ') && (c > line) && (c[-1] != ' '))
+      {
+        brk = c;
+        brk_w = w;
+      }
+      a = LCD_layout_advance(lay, &s);
+      if ((w + a - lay->spacing <= lay->width) && (s - line <= 255))
+      {
+        w += a;
+        continue;
+      }
+
+      if (!(lay->flags & LAYOUT_WRAP))
+      {
+        // the rest of the line is cut
+        end = c;
+        cut = 1;
+        while (*s && (*s != '\n'))
+          s++;
+      }
+      else if (brk)
+      {
+        end = brk;
+        w = brk_w;
+        s = brk;
+      }
+      else if (c == line)
+      {
+        end = s; // a symbol wider than the box, clipped
+        w += a;
+      }
+      else
+      {
+        end = c;
+        s = c;
+      }
+      break;
+    }
+    if (!end)
+      end = s;
+    else if (lay->flags & LAYOUT_WRAP)
+    {
+      while (*s == ' ')
+        s++;
+    }
+    if (*s == '\n')
+      s++;
+
+    lay->start[n] = line - str;
+    lay->len[n] = end - line;
+    lay->extent[n] = w ? w - lay->spacing : 0;
+    if (cut && (lay->flags & LAYOUT_ELLIPSIS))
+      LCD_layout_ellipsis(lay, str, n);
+  }
+  lay->lines = n;
+
+  // the text below the box is cut after the last line
+  if (*s && n && (lay->flags & LAYOUT_ELLIPSIS) && !(lay->cut & (1 << (n - 1))))
+    LCD_layout_ellipsis(lay, str, n - 1);
+}
+
+/**
+ * Shorten a line till "..." fits after it
+ */
+static void LCD_layout_ellipsis(lcd_layout *lay, const char *str, uint8_t line)
+{
+  const char *s = str + lay->start[line];
+  const char *end = s + lay->len[line];
+  const char *keep = s;
+  uint16_t w = 0, keep_w = 0, a;
+
+  while (s < end)
+  {
+    a = LCD_layout_advance(lay, &s);
+    if (w + a + lay->ellipsis > lay->width)
+      break;
+    w += a;
+    // no spaces before the ellipsis
+    if (s[-1] != ' ')
+    {
+      keep = s;
+      keep_w = w;
+    }
+  }
+  lay->len[line] = keep - (str + lay->start[line]);
+  lay->extent[line] = keep_w + lay->ellipsis;
+  lay->cut |= 1 << line;
+}
+
+/**
+ * Advance of the next symbol, str is moved past it
+ */
+static uint8_t LCD_layout_advance(const lcd_layout *lay, const char **str)
+{
+  if (lay->font)
+    return LCD_glyph_advance(lay->font, str, (lay->flags & LAYOUT_UTF8) ? 1 : 0);
+  if (lay->flags & LAYOUT_UTF8)
+    LCD_utf8_next(str, 0);
+  else
+    (*str)++;
+  return lay->advance;
+}
+
+static void LCD_layout_put(const lcd_layout *lay, const char *str, uint8_t len, int16_t x,
+    int16_t y, inverse_type inverse)
+{
+  uint8_t utf8 = (lay->flags & LAYOUT_UTF8) ? 1 : 0;
+
+  if (!len)
+    return;
+  if (lay->font)
+    LCD_text_part(lay->font, str, len, x, y, inverse, utf8);
+  else
+    LCD_string_part(str, len, x, y, lay->type, inverse, utf8);
+}
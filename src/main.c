@@ -1,6 +1,7 @@
 #include "stm32f10x.h"
 #include "inc/uc1601s.h"
 #include "inc/tools.h"
+#include "inc/labels.h"
 
 uint8_t i = 0;
 
@@ -19,7 +20,8 @@ int main(void) {
   TIM_ITConfig(TIM2, TIM_IT_Update, ENABLE);
   TIM_Cmd(TIM2, ENABLE);
 
-  LCD_init();
+  //Bring the display up in the background, the rest of the system doesn't wait for it
+  LCD_init_start(0);
 
   //Enable TIM2 IRQ
   NVIC_InitStructure.NVIC_IRQChannel = TIM2_IRQn;
@@ -28,35 +30,42 @@ int main(void) {
   NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
   NVIC_Init(&NVIC_InitStructure);
 
-  while (1) {}; // Infinity loop
+  while (1) { // Infinity loop
+    LCD_init_step(); // returns immediately once the display is ready
+    tool_sleep();
+  }
 }
 
 void TIM2_IRQHandler(void) {
   TIM_ClearITPendingBit(TIM2, TIM_SR_UIF );
 
+  if (!LCD_ready())
+    return;
+
   // Some LCD demonstrations
 
   switch (i++ % 7) {
     case 0:
 			LCD_clear();
-			LCD_string("Hello world!", 0, 64, FONT_TYPE_10x15, INVERSE_TYPE_NOINVERSE);
+			LCD_blit(LCD_LABEL(label_hello_10x15, FONT_TYPE_10x15, "Hello world!"), 0, 64, ROP_TYPE_COPY);
       break;
     case 1:
 			LCD_clear();
-      LCD_string("Hello world!", 0, 56, FONT_TYPE_5x8, INVERSE_TYPE_NOINVERSE);
+      LCD_blit(LCD_LABEL(label_hello_5x8, FONT_TYPE_5x8, "Hello world!"), 0, 56, ROP_TYPE_COPY);
       break;
     case 2:
 			LCD_clear();
-      LCD_string("Hello world!", 0, 48, FONT_TYPE_5x15, INVERSE_TYPE_NOINVERSE);
+      LCD_blit(LCD_LABEL(label_hello_5x15, FONT_TYPE_5x15, "Hello world!"), 0, 48, ROP_TYPE_COPY);
       break;
     case 3:
 			LCD_clear();
-      LCD_string("Hello world!", 0, 40, FONT_TYPE_10x8, INVERSE_TYPE_NOINVERSE);
+      LCD_blit(LCD_LABEL(label_hello_10x8, FONT_TYPE_10x8, "Hello world!"), 0, 40, ROP_TYPE_COPY);
       break;
     case 4: {
       char *string = "Hello world!";
 			LCD_clear();
-      LCD_rect(LINE_TYPE_BLACK, ANGLE_TYPE_ROUNDED, 1, FILL_TYPE_GRAY, 8, 8,100, 15); //tool_strlen(string) * 6 + 5 - calculate rect width for place str
+      LCD_rect(LINE_TYPE_BLACK, ANGLE_TYPE_ROUNDED, 1, FILL_TYPE_GRAY, 8, 8,
+          LCD_string_width(string, FONT_TYPE_5x8) + 6, 15); // the string fits with a margin
 //      LCD_string("Hello world!", 10, 10, FONT_TYPE_5x8, INVERSE_TYPE_INVERSE);
       break;
     }
@@ -79,5 +88,6 @@ void TIM2_IRQHandler(void) {
       break;
     }
   }
+  LCD_sync();
 }
 
@@ -0,0 +1,401 @@
+#include "inc/uc1601s.h"
+#include "inc/shapes.h"
+
+// Quarter of an oval: corner centers (xl, yt), (xr, yt), (xl, yb), (xr, yb) and the radii.
+// A circle or an ellipse has one center, a rounded rectangle has four.
+typedef struct {
+  line_type type;
+  fill_type fill;
+  int16_t xl, yt, xr, yb;
+  uint8_t outline;          // 1 - outline pass, 0 - fill pass
+  int16_t sx, sy, ex, ey;   // current outline run (horizontal or vertical)
+  int16_t lastx;            // last filled column offset
+  uint8_t dot;              // LINE_TYPE_DOT phase
+} lcd_oval;
+
+// Polygon edge stepping along the columns: y(x) = q + r / dx exactly
+typedef struct {
+  int16_t x0, y0, x1;       // x0 < x1, column x1 is not covered
+  int16_t dx, dy;
+  int16_t q, dq;            // integer part of y and its step per column
+  int16_t r, dr;            // remainder 0..dx-1 and its step
+} lcd_edge;
+
+// edge table sorted by x0 and the active edges of the current column
+static lcd_edge polyEdges[LCD_POLY_EDGES];
+static lcd_edge *polyActive[LCD_POLY_EDGES];
+
+static void LCD_oval(line_type type, fill_type fill, int16_t xl, int16_t yt, int16_t xr,
+    int16_t yb, uint8_t rx, uint8_t ry);
+static int16_t LCD_floor_div(int32_t a, int16_t b, int16_t *rem);
+static void LCD_oval_walk(lcd_oval *o, uint8_t rx, uint8_t ry);
+static void LCD_oval_point(lcd_oval *o, int16_t x, int16_t y);
+static void LCD_oval_run(lcd_oval *o);
+
+/**
+ * Draw circle
+ * @param type: LINE_TYPE_WHITE, LINE_TYPE_BLACK, LINE_TYPE_DOT - outline
+ * @param fill: FILL_TYPE_TRANSPARENT, FILL_TYPE_WHITE, FILL_TYPE_BLACK, FILL_TYPE_GRAY
+ * @param cx, cy: center
+ * @param r: radius, up to LCD_SHAPE_MAX_RADIUS
+ */
+void LCD_circle(line_type type, fill_type fill, int16_t cx, int16_t cy, uint8_t r)
+{
+  LCD_oval(type, fill, cx, cy, cx, cy, r, r);
+}
+
+/**
+ * Draw ellipse with axes parallel to the screen edges
+ * @param type: LINE_TYPE_WHITE, LINE_TYPE_BLACK, LINE_TYPE_DOT - outline
+ * @param fill: FILL_TYPE_TRANSPARENT, FILL_TYPE_WHITE, FILL_TYPE_BLACK, FILL_TYPE_GRAY
+ * @param cx, cy: center
+ * @param rx, ry: radii, up to LCD_SHAPE_MAX_RADIUS
+ */
+void LCD_ellipse(line_type type, fill_type fill, int16_t cx, int16_t cy, uint8_t rx, uint8_t ry)
+{
+  LCD_oval(type, fill, cx, cy, cx, cy, rx, ry);
+}
+
+/**
+ * Draw rectangle with round corners of any radius
+ * @param type: LINE_TYPE_WHITE, LINE_TYPE_BLACK, LINE_TYPE_DOT - frame
+ * @param fill: FILL_TYPE_TRANSPARENT, FILL_TYPE_WHITE, FILL_TYPE_BLACK, FILL_TYPE_GRAY
+ * @param x: left column
+ * @param y: lowest row
+ * @param width
+ * @param height
+ * @param radius: reduced to fit the box, 0 - square corners
+ */
+void LCD_round_rect(line_type type, fill_type fill, int16_t x, int16_t y, uint8_t width,
+    uint8_t height, uint8_t radius)
+{
+  int16_t xl, yt, xr, yb;
+
+  if (!width || !height)
+    return;
+  if (radius > (width - 1) >> 1)
+    radius = (width - 1) >> 1;
+  if (radius > (height - 1) >> 1)
+    radius = (height - 1) >> 1;
+  xl = x + radius;
+  yt = y + radius;
+  xr = x + width - 1 - radius;
+  yb = y + height - 1 - radius;
+
+  // straight part of the interior, the corner columns come from the oval
+  if (xr - xl > 1)
+    LCD_box(fill, xl + 1, y, xr - xl - 1, height);
+  LCD_oval(type, fill, xl, yt, xr, yb, radius, radius);
+  if (type == LINE_TYPE_DOT)
+    return; // the oval dots the straight edges too
+
+  if (xr - xl > 1)
+  {
+    LCD_hspan(type ? FILL_TYPE_BLACK : FILL_TYPE_WHITE, xl + 1, xr - 1, y);
+    LCD_hspan(type ? FILL_TYPE_BLACK : FILL_TYPE_WHITE, xl + 1, xr - 1, y + height - 1);
+  }
+  if (yb - yt > 1)
+  {
+    LCD_vspan(type ? FILL_TYPE_BLACK : FILL_TYPE_WHITE, x, yt + 1, yb - 1);
+    LCD_vspan(type ? FILL_TYPE_BLACK : FILL_TYPE_WHITE, x + width - 1, yt + 1, yb - 1);
+  }
+}
+
+/**
+ * Fill polygon, the vertices are joined in order and the last one to the first.
+ * Any shape goes (even-odd rule). Every column is one scanline: the active edges
+ * are crossed at the pixel centers and the spans between them are written as page
+ * byte masks. Pixels on the right edge and on the upper (higher y) edge are not filled,
+ * so polygons sharing an edge do not overlap.
+ * @param fill: FILL_TYPE_WHITE, FILL_TYPE_BLACK, FILL_TYPE_GRAY
+ * @param pts: vertices
+ * @param n: 3..LCD_POLY_EDGES
+ */
+void LCD_polygon(fill_type fill, const lcd_point *pts, uint8_t n)
+{
+  lcd_edge e, *a;
+  lcd_rect clip;
+  int16_t vx, vy, x, xs, xe, y0, y1;
+  uint8_t i, j, edges = 0, active = 0, next = 0;
+
+  if ((n < 3) || (n > LCD_POLY_EDGES) || (fill == FILL_TYPE_TRANSPARENT))
+    return;
+
+  // edge table, vertical edges never cross a column
+  xs = 0x7FFF;
+  xe = -0x7FFF;
+  for (i = 0; i < n; i++)
+  {
+    j = (i + 1 < n) ? i + 1 : 0;
+    if (pts[i].x == pts[j].x)
+      continue;
+    if (pts[i].x < pts[j].x)
+    {
+      e.x0 = pts[i].x;
+      e.y0 = pts[i].y;
+      e.x1 = pts[j].x;
+      e.dy = pts[j].y - pts[i].y;
+    }
+    else
+    {
+      e.x0 = pts[j].x;
+      e.y0 = pts[j].y;
+      e.x1 = pts[i].x;
+      e.dy = pts[i].y - pts[j].y;
+    }
+    e.dx = e.x1 - e.x0;
+    e.dq = LCD_floor_div(e.dy, e.dx, &e.dr);
+    if (e.x0 < xs)
+      xs = e.x0;
+    if (e.x1 > xe)
+      xe = e.x1;
+    for (j = edges; j && (polyEdges[j - 1].x0 > e.x0); j--)
+      polyEdges[j] = polyEdges[j - 1];
+    polyEdges[j] = e;
+    edges++;
+  }
+
+  // visible columns only
+  LCD_clip_get(&clip, &vx, &vy);
+  if (xs < clip.x0 - vx)
+    xs = clip.x0 - vx;
+  if (xe > clip.x1 - vx + 1)
+    xe = clip.x1 - vx + 1;
+
+  for (x = xs; x < xe; x++)
+  {
+    // finished edges out
+    for (i = 0, j = 0; i < active; i++)
+    {
+      if (polyActive[i]->x1 > x)
+        polyActive[j++] = polyActive[i];
+    }
+    active = j;
+
+    // edges starting here (or left of the clip) in, crossing at this column
+    for (; (next < edges) && (polyEdges[next].x0 <= x); next++)
+    {
+      a = &polyEdges[next];
+      if (a->x1 <= x)
+        continue;
+      a->q = a->y0 + LCD_floor_div((int32_t) (x - a->x0) * a->dy, a->dx, &a->r);
+      polyActive[active++] = a;
+    }
+
+    // crossings in order of y, the edges swap places only where they cross
+    for (i = 1; i < active; i++)
+    {
+      a = polyActive[i];
+      for (j = i; j && ((polyActive[j - 1]->q > a->q)
+          || ((polyActive[j - 1]->q == a->q)
+          && ((int32_t) polyActive[j - 1]->r * a->dx > (int32_t) a->r * polyActive[j - 1]->dx))); j--)
+        polyActive[j] = polyActive[j - 1];
+      polyActive[j] = a;
+    }
+
+    // rows with the pixel center inside: ceil(y) of the lower edge .. ceil(y) - 1 of the upper
+    for (i = 0; i + 1 < active; i += 2)
+    {
+      y0 = polyActive[i]->q + (polyActive[i]->r != 0);
+      y1 = polyActive[i + 1]->q + (polyActive[i + 1]->r != 0) - 1;
+      if (y0 <= y1)
+        LCD_vspan(fill, x, y0, y1);
+    }
+
+    for (i = 0; i < active; i++)
+    {
+      a = polyActive[i];
+      a->q += a->dq;
+      a->r += a->dr;
+      if (a->r >= a->dx)
+      {
+        a->q++;
+        a->r -= a->dx;
+      }
+    }
+  }
+}
+
+/**
+ * Fill pass and outline pass of an oval, every pass is one midpoint walk of a quadrant.
+ * The fill goes as vertical spans (one byte per page), the outline as runs of pixels.
+ */
+static void LCD_oval(line_type type, fill_type fill, int16_t xl, int16_t yt, int16_t xr,
+    int16_t yb, uint8_t rx, uint8_t ry)
+{
+  lcd_oval o;
+  int16_t k;
+
+  if ((rx > LCD_SHAPE_MAX_RADIUS) || (ry > LCD_SHAPE_MAX_RADIUS))
+    return;
+  o.type = type;
+  o.fill = fill;
+  o.xl = xl;
+  o.yt = yt;
+  o.xr = xr;
+  o.yb = yb;
+
+  if (fill != FILL_TYPE_TRANSPARENT)
+  {
+    o.outline = 0;
+    o.lastx = -1;
+    LCD_oval_walk(&o, rx, ry);
+  }
+
+  o.outline = 1;
+  o.dot = 0;
+  o.sx = o.ex = 0;
+  o.sy = o.ey = ry;
+  LCD_oval_walk(&o, rx, ry);
+  LCD_oval_run(&o);
+
+  if ((type == LINE_TYPE_DOT) && ((xr > xl) || (yb > yt)))
+  {
+    // dotted straight edges of a rounded rectangle
+    for (k = xl + 2; k < xr; k += 2)
+    {
+      LCD_hspan(FILL_TYPE_BLACK, k, k, yt - ry);
+      LCD_hspan(FILL_TYPE_BLACK, k, k, yb + ry);
+    }
+    for (k = yt + 2; k < yb; k += 2)
+    {
+      LCD_hspan(FILL_TYPE_BLACK, xl - rx, xl - rx, k);
+      LCD_hspan(FILL_TYPE_BLACK, xr + rx, xr + rx, k);
+    }
+  }
+}
+
+/**
+ * Midpoint ellipse walk of a quadrant from (0, ry) to (rx, 0), every pixel once
+ * The decision terms are scaled by 4 to stay integer.
+ */
+static void LCD_oval_walk(lcd_oval *o, uint8_t rx, uint8_t ry)
+{
+  int32_t a2 = (int32_t) rx * rx, b2 = (int32_t) ry * ry;
+  int32_t dx, dy, d;
+  int16_t x = 0, y = ry;
+
+  if (!ry)
+  {
+    for (x = 0; x <= rx; x++)
+      LCD_oval_point(o, x, 0);
+    return;
+  }
+
+  // region 1: the slope is under 1, x steps every pixel
+  dx = 0;
+  dy = 2 * a2 * y;
+  d = 4 * b2 - 4 * a2 * ry + a2;
+  while (dx < dy)
+  {
+    LCD_oval_point(o, x, y);
+    x++;
+    dx += 2 * b2;
+    if (d < 0)
+      d += 4 * (dx + b2);
+    else
+    {
+      y--;
+      dy -= 2 * a2;
+      d += 4 * (dx - dy + b2);
+    }
+  }
+
+  // region 2: y steps every pixel
+  d = b2 * (2 * x + 1) * (2 * x + 1) + 4 * a2 * (y - 1) * (y - 1) - 4 * a2 * b2;
+  while (y >= 0)
+  {
+    LCD_oval_point(o, x, y);
+    y--;
+    dy -= 2 * a2;
+    if (d > 0)
+      d += 4 * (a2 - dy);
+    else
+    {
+      x++;
+      dx += 2 * b2;
+      d += 4 * (dx - dy + a2);
+    }
+  }
+}
+
+/**
+ * Next pixel of the quadrant walk
+ */
+static void LCD_oval_point(lcd_oval *o, int16_t x, int16_t y)
+{
+  if (!o->outline)
+  {
+    // the first pixel of a column is its highest, the column is filled to it
+    if (x != o->lastx)
+    {
+      LCD_vspan(o->fill, o->xl - x, o->yt - y, o->yb + y);
+      if (x || (o->xr != o->xl))
+        LCD_vspan(o->fill, o->xr + x, o->yt - y, o->yb + y);
+      o->lastx = x;
+    }
+    return;
+  }
+
+  if (o->type == LINE_TYPE_DOT)
+  {
+    if (!(o->dot++ & 1))
+    {
+      o->sx = o->ex = x;
+      o->sy = o->ey = y;
+      LCD_oval_run(o);
+    }
+    return;
+  }
+
+  if ((y == o->sy) && (o->sy == o->ey) && (x == o->ex + 1))
+    o->ex = x;
+  else if ((x == o->sx) && (o->sx == o->ex) && (y == o->ey - 1))
+    o->ey = y;
+  else if ((x != o->ex) || (y != o->ey))
+  {
+    LCD_oval_run(o);
+    o->sx = o->ex = x;
+    o->sy = o->ey = y;
+  }
+}
+
+/**
+ * Current outline run mirrored into the four corners
+ */
+static void LCD_oval_run(lcd_oval *o)
+{
+  fill_type f = (o->type == LINE_TYPE_WHITE) ? FILL_TYPE_WHITE : FILL_TYPE_BLACK;
+
+  if (o->sy == o->ey)
+  {
+    LCD_hspan(f, o->xr + o->sx, o->xr + o->ex, o->yt - o->sy);
+    LCD_hspan(f, o->xl - o->sx, o->xl - o->ex, o->yt - o->sy);
+    if (o->sy || (o->yb != o->yt))
+    {
+      LCD_hspan(f, o->xr + o->sx, o->xr + o->ex, o->yb + o->sy);
+      LCD_hspan(f, o->xl - o->sx, o->xl - o->ex, o->yb + o->sy);
+    }
+  }
+  else
+  {
+    LCD_vspan(f, o->xr + o->sx, o->yt - o->sy, o->yt - o->ey);
+    LCD_vspan(f, o->xr + o->sx, o->yb + o->sy, o->yb + o->ey);
+    if (o->sx || (o->xr != o->xl))
+    {
+      LCD_vspan(f, o->xl - o->sx, o->yt - o->sy, o->yt - o->ey);
+      LCD_vspan(f, o->xl - o->sx, o->yb + o->sy, o->yb + o->ey);
+    }
+  }
+}
+
+/**
+ * Division rounding down for any sign (b > 0), rem gets 0..b-1
+ */
+static int16_t LCD_floor_div(int32_t a, int16_t b, int16_t *rem)
+{
+  int32_t q = (a >= 0) ? a / b : -((-a + b - 1) / b);
+
+  *rem = (int16_t) (a - q * b);
+  return (int16_t) q;
+}
@@ -0,0 +1,194 @@
+#include "inc/uc1601s.h"
+#include "inc/sprite.h"
+
+// one destination page span (read, merged, written back once)
+static uint8_t sprRow[132];
+
+static void LCD_sprite_update(lcd_sprite *spr, uint8_t show, uint8_t x, uint8_t y);
+static void LCD_sprite_span(lcd_sprite *spr, uint8_t show, uint8_t x, uint8_t y,
+    uint8_t page, uint8_t c0, uint8_t c1);
+static uint8_t LCD_sprite_cols(const lcd_sprite *spr, uint8_t x, uint8_t y, uint8_t page,
+    uint8_t *c0, uint8_t *c1);
+static uint8_t LCD_bmp_byte(const lcd_bitmap *bmp, uint8_t bx, uint8_t by, uint8_t page,
+    uint8_t col, uint8_t cover);
+
+/**
+ * Prepare a hidden sprite
+ * @param spr
+ * @param bmp: image
+ * @param mask: set bits are drawn, NULL - the whole box is opaque
+ * @param save: LCD_SPRITE_SAVE_SIZE(bmp->width, bmp->height) bytes of RAM
+ */
+void LCD_sprite_init(lcd_sprite *spr, const lcd_bitmap *bmp, const lcd_bitmap *mask,
+    uint8_t *save)
+{
+  spr->bmp = bmp;
+  spr->mask = mask;
+  spr->save = save;
+  spr->x = 0;
+  spr->y = 0;
+  spr->visible = 0;
+  spr->half = 0;
+}
+
+/**
+ * Show the sprite at a new place. The old place is restored in the same pass: every
+ * page gets one read and one write of the merged old+new column span.
+ * @param spr
+ * @param x
+ * @param y: any row
+ */
+void LCD_sprite_move(lcd_sprite *spr, uint8_t x, uint8_t y)
+{
+  if (spr->visible && (spr->x == x) && (spr->y == y))
+    return;
+  LCD_sprite_update(spr, 1, x, y);
+}
+
+/**
+ * Restore the background under the sprite
+ */
+void LCD_sprite_hide(lcd_sprite *spr)
+{
+  if (spr->visible)
+    LCD_sprite_update(spr, 0, spr->x, spr->y);
+}
+
+static void LCD_sprite_update(lcd_sprite *spr, uint8_t show, uint8_t x, uint8_t y)
+{
+  uint8_t page, first, last, o0, o1, n0, n1, old, cur;
+
+  // pages touched by the old and the new box
+  first = 7;
+  last = 0;
+  if (spr->visible)
+  {
+    first = spr->y >> 3;
+    last = (spr->y + spr->bmp->height - 1) >> 3;
+  }
+  if (show)
+  {
+    if ((y >> 3) < first)
+      first = y >> 3;
+    if (((y + spr->bmp->height - 1) >> 3) > last)
+      last = (y + spr->bmp->height - 1) >> 3;
+  }
+  if (last > 7)
+    last = 7;
+
+  for (page = first; page <= last; page++)
+  {
+    old = spr->visible && LCD_sprite_cols(spr, spr->x, spr->y, page, &o0, &o1);
+    cur = show && LCD_sprite_cols(spr, x, y, page, &n0, &n1);
+    if (old && cur && (n0 <= o1 + 1) && (o0 <= n1 + 1))
+    {
+      // overlapping boxes: one span
+      LCD_sprite_span(spr, show, x, y, page, (o0 < n0) ? o0 : n0, (o1 > n1) ? o1 : n1);
+    }
+    else
+    {
+      if (old)
+        LCD_sprite_span(spr, show, x, y, page, o0, o1);
+      if (cur)
+        LCD_sprite_span(spr, show, x, y, page, n0, n1);
+    }
+  }
+
+  spr->visible = show;
+  spr->x = x;
+  spr->y = y;
+  spr->half ^= 1;
+}
+
+/**
+ * Restore the old background and draw the sprite at (x, y) within columns c0..c1
+ * The background is saved into the other half of spr->save, so the halves never overlap.
+ */
+static void LCD_sprite_span(lcd_sprite *spr, uint8_t show, uint8_t x, uint8_t y,
+    uint8_t page, uint8_t c0, uint8_t c1)
+{
+  const lcd_bitmap *bmp = spr->bmp;
+  uint16_t half = (uint16_t) bmp->width * (((bmp->height + 7) >> 3) + 1);
+  uint8_t *old_save = spr->save + (spr->half ? half : 0);
+  uint8_t *new_save = spr->save + (spr->half ? 0 : half);
+  uint8_t n = c1 - c0 + 1, i, col, m, b, first, end;
+
+  LCD_page_read(page, c0, sprRow, n);
+  first = n;
+  end = 0;
+  for (i = 0; i < n; i++)
+  {
+    col = c0 + i;
+    b = sprRow[i];
+    if (spr->visible)
+    {
+      m = spr->mask ? LCD_bmp_byte(spr->mask, spr->x, spr->y, page, col, 0)
+          : LCD_bmp_byte(bmp, spr->x, spr->y, page, col, 1);
+      if (m)
+        b = (b & ~m) | (old_save[(page - (spr->y >> 3)) * bmp->width + col - spr->x] & m);
+    }
+    if (show)
+    {
+      m = spr->mask ? LCD_bmp_byte(spr->mask, x, y, page, col, 0)
+          : LCD_bmp_byte(bmp, x, y, page, col, 1);
+      if (m)
+      {
+        new_save[(page - (y >> 3)) * bmp->width + col - x] = b;
+        b = (b & ~m) | (LCD_bmp_byte(bmp, x, y, page, col, 0) & m);
+      }
+    }
+    if (b != sprRow[i])
+    {
+      sprRow[i] = b;
+      if (first == n)
+        first = i;
+      end = i + 1;
+    }
+  }
+  if (first < end)
+    LCD_page_write(page, c0 + first, &sprRow[first], end - first);
+}
+
+/**
+ * Columns of a GDRAM page covered by the sprite box at (x, y)
+ * @return 0 - the page is not covered
+ */
+static uint8_t LCD_sprite_cols(const lcd_sprite *spr, uint8_t x, uint8_t y, uint8_t page,
+    uint8_t *c0, uint8_t *c1)
+{
+  if ((page < (y >> 3)) || (page > ((y + spr->bmp->height - 1) >> 3)) || (x > 131))
+    return 0;
+  *c0 = x;
+  *c1 = ((uint16_t) x + spr->bmp->width - 1 > 131) ? 131 : x + spr->bmp->width - 1;
+  return 1;
+}
+
+/**
+ * Byte of a bitmap drawn at (bx, by) that falls into a GDRAM page and column
+ * @param cover: 1 - rows covered by the bitmap box instead of its pixels
+ */
+static uint8_t LCD_bmp_byte(const lcd_bitmap *bmp, uint8_t bx, uint8_t by, uint8_t page,
+    uint8_t col, uint8_t cover)
+{
+  uint8_t pages = (bmp->height + 7) >> 3;
+  uint8_t shift = by & 7, sp, c, lo = 0, hi = 0;
+  uint8_t last = 0xFF >> ((pages << 3) - bmp->height);
+
+  if ((col < bx) || (col - bx >= bmp->width) || (page < (by >> 3)))
+    return 0;
+  c = col - bx;
+  sp = page - (by >> 3);
+  if (sp < pages)
+  {
+    lo = (sp == pages - 1) ? last : 0xFF;
+    if (!cover)
+      lo &= bmp->data[(uint16_t) sp * bmp->width + c];
+  }
+  if (shift && sp && (sp <= pages))
+  {
+    hi = (sp == pages) ? last : 0xFF;
+    if (!cover)
+      hi &= bmp->data[(uint16_t) (sp - 1) * bmp->width + c];
+  }
+  return (uint8_t) (lo << shift) | (shift ? hi >> (8 - shift) : 0);
+}
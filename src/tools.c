@@ -1,10 +1,115 @@
 #include "stm32f10x.h"
 #include "inc/tools.h"
 
+static volatile uint32_t toolTicks; // milliseconds since tool_timebase_init
+
+static uint8_t tool_digits(char *rev, uint32_t n, uint8_t min);
+
+/**
+ * Start the SysTick millisecond timebase (does nothing if it is already running)
+ */
+void tool_timebase_init(void)
+{
+  if (SysTick->CTRL & SysTick_CTRL_ENABLE_Msk)
+    return;
+  SysTick_Config(SystemCoreClock / 1000);
+}
+
+void SysTick_Handler(void)
+{
+  toolTicks++;
+}
+
+/**
+ * Milliseconds since the timebase start
+ * Works in handlers that block SysTick too: a pending tick is taken over here.
+ */
+uint32_t tool_millis(void)
+{
+  uint32_t primask = __get_PRIMASK();
+
+  __disable_irq();
+  if (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk)
+  {
+    SCB->ICSR = SCB_ICSR_PENDSTCLR_Msk;
+    toolTicks++;
+  }
+  __set_PRIMASK(primask);
+  return toolTicks;
+}
+
+/**
+ * Microseconds since the timebase start (wraps every ~71 min)
+ */
+uint32_t tool_micros(void)
+{
+  uint32_t ms, val;
+
+  do
+  {
+    ms = tool_millis();
+    val = SysTick->VAL;
+  } while (ms != tool_millis());
+
+  return ms * 1000 + (SysTick->LOAD - val) / (SystemCoreClock / 1000000);
+}
+
+/**
+ * Deadlines: tool_expired_xx(tool_deadline_xx(t)) becomes true after t
+ */
+uint32_t tool_deadline_ms(uint32_t ms)
+{
+  return tool_millis() + ms;
+}
+
+uint32_t tool_deadline_us(uint32_t us)
+{
+  return tool_micros() + us;
+}
+
+uint8_t tool_expired_ms(uint32_t deadline)
+{
+  return (int32_t)(tool_millis() - deadline) >= 0;
+}
+
+uint8_t tool_expired_us(uint32_t deadline)
+{
+  return (int32_t)(tool_micros() - deadline) >= 0;
+}
+
+/**
+ * Sleep till the next interrupt
+ * Only in thread mode: a handler that blocks SysTick would never wake up.
+ */
+void tool_sleep(void)
+{
+  if (__get_IPSR() == 0)
+    __WFI();
+}
+
+/**
+ * Wait, sleeping between the SysTick interrupts
+ */
 void tool_delay_ms(uint32_t ms)
 {
-  volatile uint32_t nCount = (SystemCoreClock/10000)*ms;
-  for (; nCount!=0; nCount--);
+  uint32_t deadline;
+
+  tool_timebase_init();
+  deadline = tool_deadline_ms(ms);
+  while (!tool_expired_ms(deadline))
+    tool_sleep();
+}
+
+/**
+ * Short busy wait
+ */
+void tool_delay_us(uint32_t us)
+{
+  uint32_t deadline;
+
+  tool_timebase_init();
+  deadline = tool_deadline_us(us);
+  while (!tool_expired_us(deadline));
 }
 
 uint8_t tool_strlen(char * str) {
@@ -13,3 +118,90 @@ uint8_t tool_strlen(char * str) {
   return s - 1;
 }
 
+
+/**
+ * Format an integer, no printf and no division (see tool_format_fixed)
+ * @return characters written, without the terminating 0
+ */
+uint8_t tool_format_int(char *buf, uint8_t size, int32_t value, uint8_t width, uint8_t flags)
+{
+  return tool_format_fixed(buf, size, value, 0, width, flags, 0);
+}
+
+/**
+ * Format a fixed-point number: value / 10^decimals, e.g. 2345 with 2 decimals is "23.45"
+ * @param buf: the result, 0-terminated
+ * @param size: of buf, a longer result is cut
+ * @param value
+ * @param decimals: digits after the point (0-9)
+ * @param width: minimal length of the result with the unit, padded by spaces or zeros
+ * @param flags: TOOL_FMT_ZERO, TOOL_FMT_PLUS, TOOL_FMT_LEFT
+ * @param unit: put after the number, NULL - none
+ * @return characters written, without the terminating 0
+ */
+uint8_t tool_format_fixed(char *buf, uint8_t size, int32_t value, uint8_t decimals,
+    uint8_t width, uint8_t flags, const char *unit)
+{
+  char rev[10];
+  uint32_t mag = (value < 0) ? 0u - (uint32_t) value : (uint32_t) value;
+  uint8_t digits, len, pad, n = 0;
+  char sign = (value < 0) ? '-' : ((flags & TOOL_FMT_PLUS) ? '+' : 0);
+  const char *u;
+
+  if (!size)
+    return 0;
+  if (decimals > 9)
+    decimals = 9;
+  digits = tool_digits(rev, mag, decimals + 1);
+  len = digits + (decimals ? 1 : 0) + (sign ? 1 : 0);
+  for (u = unit; u && *u; u++)
+    len++;
+  pad = (width > len) ? width - len : 0;
+
+#define TOOL_PUT(c) do { if (n < size - 1) buf[n++] = (c); } while (0)
+  if (!(flags & (TOOL_FMT_ZERO | TOOL_FMT_LEFT)))
+  {
+    for (; pad; pad--)
+      TOOL_PUT(' ');
+  }
+  if (sign)
+    TOOL_PUT(sign);
+  if ((flags & TOOL_FMT_ZERO) && !(flags & TOOL_FMT_LEFT))
+  {
+    for (; pad; pad--)
+      TOOL_PUT('0');
+  }
+  while (digits--)
+  {
+    TOOL_PUT(rev[digits]);
+    if (decimals && (digits == decimals))
+      TOOL_PUT('.');
+  }
+  for (u = unit; u && *u; u++)
+    TOOL_PUT(*u);
+  for (; pad; pad--)
+    TOOL_PUT(' ');
+#undef TOOL_PUT
+  buf[n] = 0;
+  return n;
+}
+
+/**
+ * Decimal digits of n, the lowest first, at least min (leading zeros)
+ * n / 10 is a multiplication by the reciprocal 0xCCCCCCCD / 2^35, exact for any 32 bits
+ * (UMULL, no division).
+ * @return digits
+ */
+static uint8_t tool_digits(char *rev, uint32_t n, uint8_t min)
+{
+  uint32_t q;
+  uint8_t k = 0;
+
+  do
+  {
+    q = (uint32_t) (((uint64_t) n * 0xCCCCCCCDu) >> 35);
+    rev[k++] = '0' + (char) (n - q * 10);
+    n = q;
+  } while (n || (k < min));
+  return k;
+}
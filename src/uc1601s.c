@@ -2,6 +2,20 @@
 #include "inc/uc1601s.h"
 #include "inc/i2c.h"
 #include "inc/tools.h"
+#include "inc/font.h"
+
+#if LCD_FRAMEBUFFER
+  #undef LCD_GDRAM_CACHE_SIZE
+  #define LCD_GDRAM_CACHE_SIZE 0 // the framebuffer holds the whole GDRAM
+#endif
+
+#if LCD_WARM_START && (LCD_HEIGHT > 64)
+  #error "LCD_WARM_START keeps its signature in the 65-th GDRAM row, the panel must not show it"
+#endif
+
+#if LCD_GLYPH_CACHE_SIZE > 254
+  #error "LCD_GLYPH_CACHE_SIZE: the glyph cache entries are numbered by a byte"
+#endif
 
 
 //
@@ -12,8 +26,8 @@ enum _lcd_datatype
 }lcdBufType;
 
 //set column address (duoble-byte command)
-#define SET_COL_ADDR_LSB(col_addr_lsb)	0x00 | col_addr_lsb			// + column address CA[3:0] in bits [3:0]
-#define SET_COL_ADDR_MSB(col_addr_msb)	0x10 | col_addr_msb			// + column address CA[7:4] in bits [3:0]
+#define SET_COL_ADDR_LSB(col_addr_lsb)	(0x00 | (col_addr_lsb))			// + column address CA[3:0] in bits [3:0]
+#define SET_COL_ADDR_MSB(col_addr_msb)	(0x10 | (col_addr_msb))			// + column address CA[7:4] in bits [3:0]
 
 //temperature compensation
 #define SET_TEMP_COMPENS				0x24	//+	TEMP_COMP value below
@@ -30,10 +44,10 @@ enum _lcd_datatype
 #define INTERNAL_VLCD			0x06
 
 //set scroll line
-#define	SET_SCROLL_LINE(line_num)		0x40|line_num	//	+ line value in bits [5:0]
+#define	SET_SCROLL_LINE(line_num)		(0x40 | (line_num))	//	+ line value in bits [5:0]
 
 //set page address
-#define	SET_PAGE_ADDR(paddr)			0xb0|paddr	// + page address in bits [3:0]
+#define	SET_PAGE_ADDR(paddr)			(0xb0 | (paddr))	// + page address in bits [3:0]
 
 //LCD bias ratio
 #define SET_BIAS_RATIO		0xE8
@@ -50,7 +64,7 @@ enum _lcd_datatype
 #define PARTIAL_DISP_DIS	0x80
 
 //RAM address control
-#define SET_RAM_ADDR_CTRL(WA, IO, PID)		0x88 | WA | IO | PID
+#define SET_RAM_ADDR_CTRL(WA, IO, PID)		(0x88 | (WA) | (IO) | (PID))
 	//WA, wrap around enable bit
 #define	WRAP_AROUND					0x01
 #define	NO_WRAP_AROUND			0x00
@@ -84,38 +98,356 @@ enum _lcd_datatype
 #define SYSTEM_RESET			0xE2
 
 
-uint8_t cursorX, cursorY; // current position
+int16_t cursorX, cursorY; // current position (screen coordinates)
+
+// asynchronous initialization
+enum _lcd_initstate
+{
+	LCD_INIT_NONE = 0,
+	LCD_INIT_RESET,   // waiting after the reset pin release
+	LCD_INIT_CONFIG,  // waiting after SYSTEM_RESET
+	LCD_INIT_FILL,    // writing the first GDRAM content page by page
+	LCD_INIT_WARM,    // controller kept its state, configuration is refreshed
+	LCD_INIT_READBACK,// warm start: reading GDRAM back into the framebuffer
+	LCD_INIT_READY
+};
+static volatile uint8_t initState;
+static uint8_t initPage;
+static uint32_t initDeadline;
+static const uint8_t *initSplash;
+
+// write-combining buffer
+// Address commands are held back and sent only when the next data byte does not land
+// where the controller's address counter already points. Other commands and data
+// bytes are queued, the queue goes out as one transaction when its type changes, when
+// it is full, before a read or on LCD_sync().
+static uint8_t wcBuf[LCD_WC_SIZE], wcLen, wcType;
+static uint8_t wcPage, wcCol, wcKnown; // controller address counter (if known)
+static uint8_t wcRunPage, wcRunCol, wcRunKnown; // address of the first queued data byte
+static uint8_t wantPage, wantCol, wantSet; // address requested by the caller
+static uint8_t wcIncPage; // INC_PAGE_FIRST is active
+static uint8_t wcParam; // next command byte is a parameter of double-byte command
+
+// shadow framebuffer: GDRAM pages 0..7, dirty column span per page (min > max - clean)
+#if LCD_FRAMEBUFFER
+static uint8_t fb[8][132];
+static uint8_t fbDirtyMin[8], fbDirtyMax[8];
+#define FB_PIXEL(x, y)    ((fb[(y) >> 3][x] >> ((y) & 7)) & 1)
+
+// flood fill: columns to scan over the rows of the run they were reached from
+static struct {
+  uint8_t x, y0, y1;
+  int8_t dir;
+} floodStack[LCD_FLOOD_STACK];
+static uint8_t floodTop;
+#endif
+
+// warm start signature: bit 0 of the last columns of page 8 (the 65-th row)
+#define WARM_SIG          0xA5C3
+#define WARM_SIG_COLS     16
+
+// GDRAM readback cache (direct-mapped), a tag is page * 132 + column
+#if LCD_GDRAM_CACHE_SIZE
+#define CACHE_TAG_NONE 0xFFFF
+static uint16_t cacheTag[LCD_GDRAM_CACHE_SIZE];
+static uint8_t cacheData[LCD_GDRAM_CACHE_SIZE];
+static uint8_t cacheEmpty;
+#endif
+static uint32_t cacheHits, cacheMisses;
+
+// cache of the double height chargen[] symbols (LRU), a symbol is keyed by the code and
+// the inverse
+#if LCD_GLYPH_CACHE_SIZE
+#define GLYPH_NONE 0xFF
+#define GLYPH_BUCKETS 16
+#define GLYPH_HASH(code, inverse) (((uint8_t) (code) ^ ((inverse) << 3)) & (GLYPH_BUCKETS - 1))
+typedef struct {
+  uint16_t col[5];          // bit 0 - the lowest row of the cell
+  char code;
+  uint8_t inverse;
+  uint8_t chain;            // next entry of the hash bucket
+  uint8_t older, newer;     // LRU list
+} lcd_glyph_slot;
+static lcd_glyph_slot glyphSlot[LCD_GLYPH_CACHE_SIZE];
+static uint8_t glyphBucket[GLYPH_BUCKETS];
+static uint8_t glyphUsed, glyphNewest, glyphOldest;
+#endif
+static uint32_t glyphHits, glyphMisses;
+
+// flush statistics, durations in DWT cycles (the sum is 64-bit, 32 bits of cycles are
+// a few minutes of flushing)
+static uint32_t flushCount, flushDirty, flushCyclesMax, flushStart;
+static uint64_t flushCyclesSum;
+
+// clip rectangles (screen coordinates), [0] - the whole screen, and the viewport origin
+static lcd_rect clipStack[LCD_CLIP_DEPTH + 1] = {{0, 0, LCD_WIDTH - 1, LCD_HEIGHT - 1}};
+static uint8_t clipTop;
+static int16_t vpX, vpY;
+#define clip (&clipStack[clipTop])
+
+// extra attempts for GDRAM data that failed after the address was acknowledged
+// (the I2C layer doesn't repeat it, the GDRAM address is sent again here)
+#define LCD_DATA_RETRIES 2
+
+// LCD_span() works in chunks of this many columns
+#define SPAN_CHUNK 32
+
+// line pixels gathered per page: set and cleared bits of a window of columns
+#define LINE_STRIP 32
+typedef struct {
+  uint8_t page, base;
+  uint8_t lo, hi;           // used columns base + lo .. base + hi (lo > hi - empty)
+  int8_t dir;               // columns go up (1) or down (-1)
+  uint8_t set[LINE_STRIP], clr[LINE_STRIP];
+} lcd_strip;
+
+// Cohen-Sutherland outcodes
+#define CLIP_LEFT     0x01
+#define CLIP_RIGHT    0x02
+#define CLIP_TOP      0x04
+#define CLIP_BOTTOM   0x08
 
 // Symbol masks
 const char chargen[];
 
+static void LCD_write_page(uint8_t page, const uint8_t *data);
+static void LCD_send_config(void);
+static void LCD_init_cold(void);
+#if LCD_WARM_START
+static uint8_t LCD_warm_check(void);
+static void LCD_warm_sign(void);
+#endif
+#if LCD_FRAMEBUFFER
+static void LCD_fb_fill(uint8_t byte);
+static void LCD_fb_flush(void);
+static void LCD_fb_next(uint8_t *page, uint8_t *col);
+static uint8_t LCD_flood_push(int16_t x, uint8_t y0, uint8_t y1, int8_t dir, uint8_t target);
+#endif
+static void LCD_flush_begin(void);
+static void LCD_flush_end(uint16_t dirty);
+static void LCD_write(uint8_t type, uint8_t *buf, uint32_t cnt);
+#if !LCD_FRAMEBUFFER
+static uint32_t LCD_read(uint8_t type, uint8_t *buf, uint32_t cnt);
+#endif
+static void LCD_wc_cmd(uint8_t cmd);
+#if !LCD_FRAMEBUFFER
+static void LCD_wc_addr(void);
+#endif
+static void LCD_wc_put(uint8_t type, uint8_t byte);
+static void LCD_wc_flush(void);
+static uint32_t LCD_data_send(uint8_t page, uint8_t col, uint8_t known, uint8_t *buf,
+    uint32_t cnt);
+static void LCD_read_gdram(uint8_t *buf, uint8_t cnt);
+#if LCD_GDRAM_CACHE_SIZE
+static uint8_t LCD_cache_get(uint8_t page, uint8_t col, uint8_t *byte);
+static void LCD_cache_put(uint8_t page, uint8_t col, uint8_t byte);
+#endif
+static void LCD_cache_clear(void);
+static void LCD_plot(uint8_t pixel_type, uint8_t x, uint8_t y);
+static void LCD_pixel_clip(uint8_t pixel_type, int16_t x, int16_t y);
+static void LCD_line_clip(line_type type, int16_t x0, int16_t y0, int16_t x1, int16_t y1);
+static void LCD_line_draw(uint32_t set, uint32_t clr, uint8_t width, int16_t x0, int16_t y0,
+    int16_t x1, int16_t y1, uint8_t clipped);
+static uint32_t LCD_line_pattern(line_type type);
+static void LCD_line_hrun(lcd_strip *strip, uint32_t set, uint32_t clr, int16_t x0, int16_t x1,
+    int16_t y);
+static void LCD_line_vrun(lcd_strip *strip, uint32_t set, uint32_t clr, int16_t x, int16_t y0,
+    int16_t y1);
+static void LCD_line_thick(uint32_t pattern, fill_type fill, uint8_t step, int16_t m0,
+    int16_t m1, int16_t n0, int16_t n1);
+static uint16_t LCD_isqrt(uint32_t a);
+static void LCD_strip_put(lcd_strip *strip, uint8_t page, uint8_t col, uint8_t set, uint8_t clr);
+static void LCD_strip_flush(lcd_strip *strip);
+static void LCD_rect_clip(line_type frame_type, angle_type ang_type, uint8_t border_width,
+    fill_type fill, int16_t x0, int16_t y0, uint8_t width, uint8_t height);
+static uint8_t LCD_clip_code(int16_t x, int16_t y);
+static void LCD_box_clip(fill_type fill, int16_t x0, int16_t y0, int16_t x1, int16_t y1);
+static void LCD_span(fill_type fill, uint8_t page, uint8_t c0, uint8_t c1, uint8_t mask);
+static void LCD_cursor_addr(void);
+static void LCD_font_scale(font_type font, uint8_t *width, uint8_t *height);
+static void LCD_symbol_columns(char code, uint8_t heightf, inverse_type inverse,
+    uint32_t *cols);
+#if LCD_GLYPH_CACHE_SIZE
+static void LCD_glyph_newest(uint8_t e, uint8_t linked);
+#endif
+static void LCD_glyph_clear(void);
+
 /**
- * Initializaton
+ * Initializaton (blocking, sleeps while waiting)
  */
 void LCD_init(void)
+{
+  LCD_init_start(0);
+  while (!LCD_init_step())
+    tool_sleep();
+}
+
+/**
+ * Start the asynchronous initialization. LCD_init_step() has to be called then
+ * (from the main loop or a timer) till it returns 1.
+ * @param splash: NULL - clear the screen, otherwise page-format image
+ *   (LCD_HEIGHT/8 pages of LCD_WIDTH bytes) that becomes the first GDRAM content
+ */
+void LCD_init_start(const uint8_t *splash)
 {
   GPIO_InitTypeDef gpio_port;
-	uint8_t lcdBuff[5] = {0};
-	
 	
+  // DWT cycle counter for the statistics
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
   //Init reset pin (PC0)
   RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOC, ENABLE);
 
+#if LCD_WARM_START
+  GPIO_SetBits(GPIOC, GPIO_Pin_0); // the pin becomes an output without resetting the controller
+#endif
   gpio_port.GPIO_Pin = GPIO_Pin_0;
   gpio_port.GPIO_Mode = GPIO_Mode_Out_PP;
   gpio_port.GPIO_Speed = GPIO_Speed_10MHz;
   GPIO_Init(GPIOC, &gpio_port);
-  GPIO_ResetBits(GPIOC, GPIO_Pin_0 );
 
-  GPIO_WriteBit(GPIOC, GPIO_Pin_0, Bit_SET); // Unreset
   I2C_LowLevel_Init();
-  tool_delay_ms(10); // 1ms - 10ms
+  LCD_cache_clear();
+  LCD_glyph_clear();
+  initSplash = splash;
+
+#if LCD_WARM_START
+  // after an MCU reset the controller may still be configured and showing the picture
+  if (LCD_warm_check())
   {
+    initState = LCD_INIT_WARM;
+    return;
+  }
+#endif
+
+  LCD_init_cold();
+}
+
+/**
+ * Reset the controller, the initialization continues from LCD_INIT_RESET
+ */
+static void LCD_init_cold(void)
+{
+#if LCD_FRAMEBUFFER
+  // GDRAM content is unknown: everything is sent on the first flush
+  LCD_fb_fill(0);
+  for (initPage = 0; initPage < 8; initPage++)
+  {
+    fbDirtyMin[initPage] = 0;
+    fbDirtyMax[initPage] = 131;
+  }
+#endif
+
+  GPIO_ResetBits(GPIOC, GPIO_Pin_0 );
+  GPIO_WriteBit(GPIOC, GPIO_Pin_0, Bit_SET); // Unreset
+
+  initDeadline = tool_deadline_ms(10); // 1ms - 10ms
+  initState = LCD_INIT_RESET;
+}
+
+/**
+ * Do the next initialization step, never waits
+ * @return 1 - display is ready, 0 - call again later
+ */
+uint8_t LCD_init_step(void)
+{
+	uint8_t lcdBuff[4];
+
+  switch (initState)
+  {
+    case LCD_INIT_RESET:
+      if (!tool_expired_ms(initDeadline))
+        return 0;
 	//    uint8_t buf[] = { b11100010 }; //System Reset
-		uint8_t buf[] = { SYSTEM_RESET }; //System Reset
-    I2C_WrBuf(LcdCmd, buf, sizeof(buf));
+      lcdBuff[0] = SYSTEM_RESET; //System Reset
+      LCD_write(LcdCmd, lcdBuff, 1);
+      LCD_sync();
+      initDeadline = tool_deadline_ms(10); // 1ms - 10ms
+      initState = LCD_INIT_CONFIG;
+      return 0;
+
+    case LCD_INIT_CONFIG:
+      if (!tool_expired_ms(initDeadline))
+        return 0;
+      LCD_send_config();
+      LCD_sync();
+      initPage = 0;
+      initState = LCD_INIT_FILL;
+      return 0;
+
+    case LCD_INIT_FILL:
+      // one page per step: the splash image or blank
+      if (initSplash && (initPage < LCD_HEIGHT / 8))
+        LCD_write_page(initPage, initSplash + (uint16_t) initPage * LCD_WIDTH);
+      else
+        LCD_write_page(initPage, 0);
+      LCD_sync();
+      if (++initPage < 8)
+        return 0;
+#if LCD_WARM_START
+      LCD_warm_sign();
+#endif
+      initState = LCD_INIT_READY;
+      return 1;
+
+    case LCD_INIT_WARM:
+      // harmless for the picture, repairs a partially lost configuration
+      LCD_send_config();
+      LCD_wc_flush(); // not LCD_sync(): the framebuffer isn't read back yet
+      initPage = 0;
+#if LCD_FRAMEBUFFER
+      initState = LCD_INIT_READBACK;
+      return 0;
+#else
+      initState = LCD_INIT_READY;
+      return 1;
+#endif
+
+#if LCD_FRAMEBUFFER
+    case LCD_INIT_READBACK:
+      // rehydrate the framebuffer, one page per step
+      lcdBuff[0] = SET_RAM_ADDR_CTRL(WRAP_AROUND,INC_COL_FIRST,PAGE_INC_DIR_NORMAL);
+      lcdBuff[1] = SET_PAGE_ADDR(initPage);
+      lcdBuff[2] = SET_COL_ADDR_LSB(0);
+      lcdBuff[3] = SET_COL_ADDR_MSB(0);
+      if (I2C_WrBuf(LcdCmd, lcdBuff, 4) || I2C_RdBuf(LcdData, lcdBuff, 1) // fake read
+          || I2C_RdBuf(LcdData, fb[initPage], sizeof(fb[initPage])))
+      {
+        // the framebuffer can't be trusted to match the panel, start over cold
+        LCD_init_cold();
+        return 0;
+      }
+      fbDirtyMin[initPage] = 0xFF;
+      fbDirtyMax[initPage] = 0;
+      if (++initPage < 8)
+        return 0;
+      initState = LCD_INIT_READY;
+      return 1;
+#endif
+
+    case LCD_INIT_READY:
+      return 1;
+
+    default: // not started
+      return 0;
   }
-  tool_delay_ms(10); // 1ms - 10ms
+}
+
+/**
+ * @return 1 - initialization is complete
+ */
+uint8_t LCD_ready(void)
+{
+  return initState == LCD_INIT_READY;
+}
+
+/**
+ * Configuration burst (bias, mapping, display on)
+ */
+static void LCD_send_config(void)
+{
+	uint8_t lcdBuff[5] = {0};
 
 #ifdef LCD154
   {
@@ -129,7 +461,7 @@ void LCD_init(void)
 		lcdBuff[2] = 120;
 		lcdBuff[3] = SET_MAPPING_CONTROL(MIRROR_X, 0);
 		lcdBuff[4] = SET_DISPL_ENABLE;
-    I2C_WrBuf(LcdCmd, lcdBuff, sizeof(lcdBuff));
+    LCD_write(LcdCmd, lcdBuff, sizeof(lcdBuff));
   }
 #else
   {
@@ -140,30 +472,102 @@ void LCD_init(void)
 		lcdBuff[2] = 120;
 		lcdBuff[3] = SET_MAPPING_CONTROL(0, 0);
 		lcdBuff[4] = SET_DISPL_ENABLE;
-    I2C_WrBuf(LcdCmd, lcdBuff, sizeof(lcdBuff));
+    LCD_write(LcdCmd, lcdBuff, sizeof(lcdBuff));
   }
 #endif
+}
+
+#if LCD_WARM_START
+/**
+ * Is the controller still configured after an MCU reset?
+ * @return 1 - the signature written by a previous cold start is in the GDRAM
+ */
+static uint8_t LCD_warm_check(void)
+{
+  uint8_t lcdBuff[WARM_SIG_COLS];
+  uint16_t sig = 0;
+  uint8_t j;
+
+  lcdBuff[0] = SET_RAM_ADDR_CTRL(WRAP_AROUND,INC_COL_FIRST,PAGE_INC_DIR_NORMAL);
+  lcdBuff[1] = SET_PAGE_ADDR(8);
+  lcdBuff[2] = SET_COL_ADDR_LSB((132 - WARM_SIG_COLS) & 0x0f);
+  lcdBuff[3] = SET_COL_ADDR_MSB((132 - WARM_SIG_COLS) >> 4);
+  if (I2C_WrBuf(LcdCmd, lcdBuff, 4) != I2C_ERR_NONE)
+    return 0;
+  if (I2C_RdBuf(LcdData, lcdBuff, 1) != I2C_ERR_NONE) // fake read
+    return 0;
+  if (I2C_RdBuf(LcdData, lcdBuff, WARM_SIG_COLS) != I2C_ERR_NONE)
+    return 0;
+
+  for (j = 0; j < WARM_SIG_COLS; j++)
+    sig = (sig << 1) | (lcdBuff[j] & 0x01); // page 8 has only one row
+  return sig == WARM_SIG;
+}
 
-  LCD_clear();
+/**
+ * Leave the signature for the next warm start (straight to GDRAM, page 8 is not buffered)
+ */
+static void LCD_warm_sign(void)
+{
+  uint8_t lcdBuff[WARM_SIG_COLS];
+  uint8_t j;
+
+  LCD_sync();
+  lcdBuff[0] = SET_RAM_ADDR_CTRL(WRAP_AROUND,INC_COL_FIRST,PAGE_INC_DIR_NORMAL);
+  lcdBuff[1] = SET_PAGE_ADDR(8);
+  lcdBuff[2] = SET_COL_ADDR_LSB((132 - WARM_SIG_COLS) & 0x0f);
+  lcdBuff[3] = SET_COL_ADDR_MSB((132 - WARM_SIG_COLS) >> 4);
+  I2C_WrBuf(LcdCmd, lcdBuff, 4);
+  for (j = 0; j < WARM_SIG_COLS; j++)
+    lcdBuff[j] = (WARM_SIG >> (WARM_SIG_COLS - 1 - j)) & 0x01;
+  I2C_WrBuf(LcdData, lcdBuff, WARM_SIG_COLS);
+  wcKnown = 0;
+  wcIncPage = 0;
 }
+#endif
 
 /**
  * Clear display
  */
 void LCD_clear(void)
 {
+#if LCD_FRAMEBUFFER
+  LCD_fb_fill(0);
+#else
 	uint16_t j;
 	uint8_t lcdBuff[] = {SET_PAGE_ADDR(0), 
 												SET_COL_ADDR_LSB(0),
 												SET_COL_ADDR_MSB(0)};
 
-	I2C_WrBuf(LcdCmd, lcdBuff, sizeof(lcdBuff));
+	LCD_flush_begin();
+	LCD_write(LcdCmd, lcdBuff, sizeof(lcdBuff));
 	
 	lcdBuff[0] = 0;
   for (j = 0; j < 1056; j++){
-		I2C_WrBuf(LcdData, lcdBuff, 1);
+		LCD_write(LcdData, lcdBuff, 1);
 	}
-	
+	LCD_sync();
+	LCD_flush_end(1056);
+#endif
+}
+
+/**
+ * Write a whole GDRAM page
+ * @param page
+ * @param data: LCD_WIDTH bytes, NULL - blank page
+ */
+static void LCD_write_page(uint8_t page, const uint8_t *data)
+{
+  uint8_t j, byte = 0;
+	uint8_t lcdBuff[] = {SET_PAGE_ADDR(page), SET_COL_ADDR_LSB(0), SET_COL_ADDR_MSB(0)};
+
+  LCD_write(LcdCmd, lcdBuff, sizeof(lcdBuff));
+  for (j = 0; j < 132; j++)
+  {
+    if (data)
+      byte = (j < LCD_WIDTH) ? data[j] : 0;
+    LCD_write(LcdData, &byte, 1);
+  }
 }
 
 /**
@@ -172,18 +576,183 @@ void LCD_clear(void)
  */
 void LCD_fill(uint8_t type)
 {
+#if LCD_FRAMEBUFFER
+  LCD_fb_fill(type);
+#else
   uint16_t j;
 	uint8_t lcdBuff[] = {SET_PAGE_ADDR(0), SET_COL_ADDR_LSB(0), SET_COL_ADDR_MSB(0)};
 	
-  I2C_WrBuf(LcdCmd, lcdBuff, sizeof(lcdBuff));
+  LCD_flush_begin();
+  LCD_write(LcdCmd, lcdBuff, sizeof(lcdBuff));
 
   lcdBuff[0] = type;
   for (j = 0; j < 1056; j++)
   {
-    I2C_WrBuf(LcdData, lcdBuff, 0);
+    LCD_write(LcdData, lcdBuff, 1);
+  }
+  LCD_sync();
+  LCD_flush_end(1056);
+#endif
+}
+
+
+/**
+ * Write a run of bytes into one GDRAM page, the run is clipped at column 131.
+ * Without the framebuffer the run goes to the controller as a single data transaction.
+ * @param page: 0-7
+ * @param x: first column
+ * @param data: page-format bytes (bit 0 - the lowest row of the page)
+ * @param len
+ */
+void LCD_page_write(uint8_t page, uint8_t x, const uint8_t *data, uint8_t len)
+{
+#if LCD_FRAMEBUFFER
+  uint8_t col;
+
+  if ((page > 7) || (x > 131))
+    return;
+  if (len > 132 - x)
+    len = 132 - x;
+  for (col = x; len--; col++)
+  {
+    if (fb[page][col] != *data)
+    {
+      fb[page][col] = *data;
+      if (col < fbDirtyMin[page])
+        fbDirtyMin[page] = col;
+      if (col > fbDirtyMax[page])
+        fbDirtyMax[page] = col;
+    }
+    data++;
+  }
+#else
+	uint8_t lcdBuff[4];
+	uint8_t n = 0;
+
+  if ((page > 7) || (x > 131) || !len)
+    return;
+  if (len > 132 - x)
+    len = 132 - x;
+  if (wcIncPage)
+    lcdBuff[n++] = SET_RAM_ADDR_CTRL(WRAP_AROUND,INC_COL_FIRST,PAGE_INC_DIR_NORMAL);
+  lcdBuff[n++] = SET_PAGE_ADDR(page);
+  lcdBuff[n++] = SET_COL_ADDR_LSB(x & 0x0f);
+  lcdBuff[n++] = SET_COL_ADDR_MSB(x >> 4);
+  LCD_write(LcdCmd, lcdBuff, n);
+  LCD_write(LcdData, (uint8_t *) data, len);
+#endif
+}
+
+
+/**
+ * Read a run of bytes from one GDRAM page (the framebuffer or the cache when present)
+ * @param page: 0-7
+ * @param x: first column
+ * @param data: filled by the function, bytes beyond column 131 are 0
+ * @param len
+ */
+void LCD_page_read(uint8_t page, uint8_t x, uint8_t *data, uint8_t len)
+{
+#if LCD_FRAMEBUFFER
+  while (len--)
+    *data++ = ((page < 8) && (x < 132)) ? fb[page][x++] : 0;
+#else
+	uint8_t lcdBuff[4];
+	uint8_t n;
+
+  while (len)
+  {
+    if ((page > 7) || (x > 131))
+    {
+      *data++ = 0;
+      len--;
+      continue;
+    }
+    n = 0;
+    if (wcIncPage)
+      lcdBuff[n++] = SET_RAM_ADDR_CTRL(WRAP_AROUND,INC_COL_FIRST,PAGE_INC_DIR_NORMAL);
+    lcdBuff[n++] = SET_PAGE_ADDR(page);
+    lcdBuff[n++] = SET_COL_ADDR_LSB(x & 0x0f);
+    lcdBuff[n++] = SET_COL_ADDR_MSB(x >> 4);
+    LCD_write(LcdCmd, lcdBuff, n);
+    n = (len > 8) ? 8 : len;
+    if (n > 132 - x)
+      n = 132 - x;
+    LCD_read_gdram(data, n);
+    data += n;
+    x += n;
+    len -= n;
   }
+#endif
+}
+
+
+/**
+ * Set the viewport origin, coordinates of the primitives are relative to it
+ * @param x, y: screen coordinates, may be negative
+ */
+void LCD_viewport(int16_t x, int16_t y)
+{
+  vpX = x;
+  vpY = y;
+}
+
+/**
+ * Narrow the clip rectangle, it is intersected with the current one
+ * @param x, y: viewport coordinates
+ * @param width
+ * @param height
+ * @return 0 - the stack is full (LCD_CLIP_DEPTH), nothing changed
+ */
+uint8_t LCD_clip_push(int16_t x, int16_t y, uint8_t width, uint8_t height)
+{
+  lcd_rect *r;
+
+  if (clipTop >= LCD_CLIP_DEPTH)
+    return 0;
+  r = &clipStack[clipTop + 1];
+  x += vpX;
+  y += vpY;
+  r->x0 = (x > clip->x0) ? x : clip->x0;
+  r->y0 = (y > clip->y0) ? y : clip->y0;
+  r->x1 = (x + width - 1 < clip->x1) ? x + width - 1 : clip->x1;
+  r->y1 = (y + height - 1 < clip->y1) ? y + height - 1 : clip->y1;
+  clipTop++; // may be empty (x0 > x1): everything is culled then
+  return 1;
+}
+
+/**
+ * Restore the previous clip rectangle
+ */
+void LCD_clip_pop(void)
+{
+  if (clipTop)
+    clipTop--;
+}
+
+/**
+ * Drop all clip rectangles and the viewport offset
+ */
+void LCD_clip_reset(void)
+{
+  clipTop = 0;
+  vpX = 0;
+  vpY = 0;
 }
 
+/**
+ * Current clip rectangle and viewport
+ * @param rect: clip rectangle in screen coordinates (may be empty, x0 > x1)
+ * @param x, y: viewport origin, NULL - not needed
+ */
+void LCD_clip_get(lcd_rect *rect, int16_t *x, int16_t *y)
+{
+  *rect = *clip;
+  if (x)
+    *x = vpX;
+  if (y)
+    *y = vpY;
+}
 
 /**
  * Plot pixel
@@ -192,6 +761,21 @@ void LCD_fill(uint8_t type)
  * @param y 0-LCD_HEIGHT-1
  */
 void LCD_pixel(uint8_t pixel_type, uint8_t x, uint8_t y)
+{
+  LCD_pixel_clip(pixel_type, vpX + x, vpY + y);
+}
+
+static void LCD_pixel_clip(uint8_t pixel_type, int16_t x, int16_t y)
+{
+  if ((x < clip->x0) || (x > clip->x1) || (y < clip->y0) || (y > clip->y1))
+    return;
+  LCD_plot(pixel_type, x, y);
+}
+
+/**
+ * Plot pixel, screen coordinates without clipping
+ */
+static void LCD_plot(uint8_t pixel_type, uint8_t x, uint8_t y)
 {
 
   uint8_t page, page_num, bit_num;
@@ -205,10 +789,9 @@ void LCD_pixel(uint8_t pixel_type, uint8_t x, uint8_t y)
 	lcdBuff[1] = SET_COL_ADDR_LSB(x & 0x0f);
 	lcdBuff[2] = SET_COL_ADDR_MSB(x >> 4);
 		
-  I2C_WrBuf(LcdCmd, lcdBuff, sizeof(lcdBuff));
+  LCD_write(LcdCmd, lcdBuff, sizeof(lcdBuff));
 
-  I2C_RdBuf(LcdData, &page, sizeof(page)); //fake read
-  I2C_RdBuf(LcdData, &page, sizeof(page)); //read background
+  LCD_read_gdram(&page, sizeof(page)); //read background
 
   // modify
   if (pixel_type)
@@ -227,10 +810,10 @@ void LCD_pixel(uint8_t pixel_type, uint8_t x, uint8_t y)
 	lcdBuff[1] = SET_COL_ADDR_LSB(x & 0x0f);
 	lcdBuff[2] = SET_COL_ADDR_MSB(x >> 4);
 		
-  I2C_WrBuf(LcdCmd, lcdBuff, sizeof(lcdBuff));
+  LCD_write(LcdCmd, lcdBuff, sizeof(lcdBuff));
 
   // write page again
-  I2C_WrBuf(LcdData, &page, sizeof(page));
+  LCD_write(LcdData, &page, sizeof(page));
 }
 
 /**
@@ -242,10 +825,100 @@ void LCD_pixel(uint8_t pixel_type, uint8_t x, uint8_t y)
  * @param y1
  */
 void LCD_line(line_type type, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1)
+{
+  LCD_line_clip(type, vpX + x0, vpY + y0, vpX + x1, vpY + y1);
+}
+
+/**
+ * Line in screen coordinates: outcodes reject it or let it go without per-pixel checks
+ */
+static void LCD_line_clip(line_type type, int16_t x0, int16_t y0, int16_t x1, int16_t y1)
+{
+  uint8_t code0 = LCD_clip_code(x0, y0);
+  uint8_t code1 = LCD_clip_code(x1, y1);
+
+  uint32_t pattern = LCD_line_pattern(type);
+
+  if (code0 & code1)
+    return; // both ends beyond the same edge
+  LCD_line_draw(pattern, ~pattern, 1, x0, y0, x1, y1, code0 | code1);
+}
+
+/**
+ * Line drawn with a pen: color, width and dash pattern
+ * A wide line is a run of boxes (one per run of the thin line and dash), every box is
+ * spans of page bytes, so the cost follows the covered area. The width is kept across
+ * the line, the ends are cut square to the major axis.
+ * @param pen
+ * @param x0
+ * @param y0
+ * @param x1
+ * @param y1
+ */
+void LCD_line_pen(const lcd_pen *pen, int16_t x0, int16_t y0, int16_t x1, int16_t y1)
+{
+  uint32_t pattern = pen->pattern;
+  uint8_t code0, code1;
+
+  if (!pen->width)
+    return;
+  // repeat a short pattern to 32 bits, so it stays page-aligned
+  if (pen->length <= 8)
+    pattern = (pattern & 0xFF) * 0x01010101;
+  else if (pen->length <= 16)
+    pattern = (pattern & 0xFFFF) * 0x00010001;
+
+  x0 += vpX;
+  y0 += vpY;
+  x1 += vpX;
+  y1 += vpY;
+  if (pen->width > 1)
+  {
+    LCD_line_draw(pen->color ? pattern : 0, pen->color ? 0 : pattern, pen->width,
+        x0, y0, x1, y1, 0);
+    return;
+  }
+  code0 = LCD_clip_code(x0, y0);
+  code1 = LCD_clip_code(x1, y1);
+  if (!(code0 & code1))
+    LCD_line_draw(pen->color ? pattern : 0, pen->color ? 0 : pattern, 1, x0, y0, x1, y1,
+        code0 | code1);
+}
+
+static uint8_t LCD_clip_code(int16_t x, int16_t y)
+{
+  uint8_t code = 0;
+
+  if (x < clip->x0)
+    code |= CLIP_LEFT;
+  else if (x > clip->x1)
+    code |= CLIP_RIGHT;
+  if (y < clip->y0)
+    code |= CLIP_TOP;
+  else if (y > clip->y1)
+    code |= CLIP_BOTTOM;
+  return code;
+}
+
+/**
+ * Run-sliced Bresenham's line in screen coordinates
+ * Every minor step starts a run of pixels along the major axis, its length comes from
+ * the error term in one division. The runs are gathered per page as set/clear column
+ * masks, a page strip is read and written once. The pixels are those of the plain
+ * Bresenham's line, a clipped line starts at the clip edge with the error term it would
+ * have there.
+ * @param set, clr: pixels set / cleared, bit n - pixel n of every 32 along the major axis
+ * @param width: 1 - thin line, more - every run is widened into a box (clipped is 0 then)
+ * @param clipped: 0 - the line is inside the clip rectangle
+ */
+static void LCD_line_draw(uint32_t set, uint32_t clr, uint8_t width, int16_t x0, int16_t y0,
+    int16_t x1, int16_t y1, uint8_t clipped)
 {
 
-  uint8_t step, t, pixel_type, x, y, ystep;
+  uint8_t step;
+  int16_t t, x, y, ystep, lo, hi, k, n, len, wa, wb;
   int16_t deltax, deltay, error;
+  lcd_strip strip;
 
   step = (TOOL_ABS(y1-y0) > TOOL_ABS(x1-x0));
 
@@ -277,105 +950,556 @@ void LCD_line(line_type type, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1)
     ystep = 1;
   else
     ystep = -1;
-  for (x = x0; x < x1 + 1; x++)
+
+  // minor axis bounds
+  lo = step ? clip->x0 : clip->y0;
+  hi = step ? clip->x1 : clip->y1;
+  if (clipped)
   {
-    if (type == LINE_TYPE_WHITE)
-      pixel_type = 0;
-    else if (type == LINE_TYPE_BLACK)
-      pixel_type = 1;
-    else
-      pixel_type = x & ((uint8_t) type - 1);
-    if (step)
-      LCD_pixel(pixel_type, y, x);
+    // major axis range inside the clip rectangle
+    if (x1 > (step ? clip->y1 : clip->x1))
+      x1 = step ? clip->y1 : clip->x1;
+    k = (step ? clip->y0 : clip->x0) - x0;
+    if (k > 0)
+    {
+      if (x0 + k > x1)
+        return;
+      n = ((int32_t) 2 * k * deltay + deltax) / (2 * deltax); // minor steps done before
+      y += ystep * n;
+      error = (int32_t) k * deltay - (int32_t) n * deltax;
+      x0 += k;
+    }
+  }
+
+  // rows (columns) across the major axis for the width
+  wa = wb = 0;
+  if (width > 1)
+  {
+    t = width;
+    if (deltax)
+      t = ((uint32_t) width * LCD_isqrt((int32_t) deltax * deltax + (int32_t) deltay * deltay)
+          + (deltax >> 1)) / deltax;
+    wa = (t - 1) >> 1;
+    wb = t - 1 - wa;
+  }
+
+  strip.lo = 0xFF;
+  strip.hi = 0;
+  strip.dir = step ? ystep : 1;
+  for (k = 0; k < LINE_STRIP; k++)
+  {
+    strip.set[k] = 0;
+    strip.clr[k] = 0;
+  }
+
+  for (x = x0; x <= x1; x += len)
+  {
+    // pixels till the error term reaches deltax / 2 (2 * error < deltax here)
+    if (deltay)
+      len = ((int32_t) deltax - 2 * error + 2 * deltay - 1) / (2 * deltay);
     else
-      LCD_pixel(pixel_type, x, y);
-    error += deltay;
-    if ((error << 1) >= deltax)
+      len = x1 - x + 1;
+    if (len > x1 - x + 1)
+      len = x1 - x + 1;
+
+    if (width > 1)
+      LCD_line_thick(set | clr, set ? FILL_TYPE_BLACK : FILL_TYPE_WHITE, step, x, x + len - 1,
+          y - wa, y + wb);
+    else if (!clipped || ((y >= lo) && (y <= hi)))
     {
-      y += ystep;
-      error -= deltax;
+      if (step)
+        LCD_line_vrun(&strip, set, clr, y, x, x + len - 1);
+      else
+        LCD_line_hrun(&strip, set, clr, x, x + len - 1, y);
     }
+    error += len * deltay - deltax;
+    y += ystep;
   }
+  LCD_strip_flush(&strip);
 }
 
 /**
- * Draw rectangle
- * @param frame_type: LINE_TYPE_WHITE, LINE_TYPE_BLACK, LINE_TYPE_DOT, others - pattern
- * @param ang_type: ANGLE_TYPE_RECT , ANGLE_TYPE_ROUNDED
- * @param border_width: 0 - no, but with 1 px indent
- * @param fill: FILL_TRANSPARENT, FILL_WHITE, FILL_GRAY, FILL_SEA, other pattern
- * @param x0
- * @param y0
- * @param width
- * @param height
+ * Pixel pattern along the major axis, bit n - pixel n of every 32 (1 - black)
+ * LINE_TYPE_DOT and the other types keep the pixels of "x & (type - 1)".
  */
-void LCD_rect(line_type frame_type, angle_type ang_type, uint8_t border_width,
-    fill_type fill, uint8_t x0, uint8_t y0, uint8_t width, uint8_t height)
+static uint32_t LCD_line_pattern(line_type type)
 {
+  uint32_t pattern = 0;
+  uint8_t i;
+
+  if (type == LINE_TYPE_WHITE)
+    return 0;
+  if (type == LINE_TYPE_BLACK)
+    return 0xFFFFFFFF;
+  for (i = 0; i < 32; i++)
+  {
+    if (i & ((uint8_t) type - 1))
+      pattern |= (uint32_t) 1 << i;
+  }
+  return pattern;
+}
 
-  char a, b, x1, y1;
+/**
+ * Horizontal run x0..x1 in row y, one bit of each column
+ */
+static void LCD_line_hrun(lcd_strip *strip, uint32_t set, uint32_t clr, int16_t x0, int16_t x1,
+    int16_t y)
+{
+  uint8_t bit = 1 << (y & 7);
 
-  char filler = 0;
-  char steep, t, vid;
-  int deltax, deltay, error;
-  char x, y, poi;
-  char ystep;
-  char zx0, zy0, zy1, zx1;
-  uint8_t RIS;
+  for (; x0 <= x1; x0++)
+  {
+    if ((set >> (x0 & 31)) & 1)
+      LCD_strip_put(strip, y >> 3, x0, bit, 0);
+    else if ((clr >> (x0 & 31)) & 1)
+      LCD_strip_put(strip, y >> 3, x0, 0, bit);
+  }
+}
 
-  x1 = x0 + width - 1;
-  y1 = y0 + height - 1;
-  if (border_width)
+/**
+ * Vertical run y0..y1 in column x, one mask per page. The pattern is page-aligned
+ * (32 rows are 4 pages), so a page takes a byte of it.
+ */
+static void LCD_line_vrun(lcd_strip *strip, uint32_t set, uint32_t clr, int16_t x, int16_t y0,
+    int16_t y1)
+{
+  uint8_t page, mask;
+
+  for (page = y0 >> 3; page <= (y1 >> 3); page++)
+  {
+    mask = 0xFF;
+    if (page == (y0 >> 3))
+      mask &= 0xFF << (y0 & 7);
+    if (page == (y1 >> 3))
+      mask &= 0xFF >> (7 - (y1 & 7));
+    LCD_strip_put(strip, page, x, mask & (uint8_t) (set >> ((page & 3) << 3)),
+        mask & (uint8_t) (clr >> ((page & 3) << 3)));
+  }
+}
+
+/**
+ * Run m0..m1 along the major axis widened to n0..n1 across it, split into dashes
+ * @param pattern: drawn pixels, bit n - pixel n of every 32 along the major axis
+ * @param step: 1 - the major axis is y
+ */
+static void LCD_line_thick(uint32_t pattern, fill_type fill, uint8_t step, int16_t m0,
+    int16_t m1, int16_t n0, int16_t n1)
+{
+  int16_t m;
+
+  while (m0 <= m1)
   {
-    if (ang_type == ANGLE_TYPE_RECT)
+    // one dash or gap
+    for (m = m0; (m < m1) && (((pattern >> ((m + 1) & 31)) & 1) == ((pattern >> (m0 & 31)) & 1)); m++)
+      ;
+    if ((pattern >> (m0 & 31)) & 1)
     {
-      b = 0;
-      for (a = 0; a < border_width; a++)
-      {
-        LCD_line(frame_type, x0 + b, y0 + a, x1 - b, y0 + a);
-        LCD_line(frame_type, x1 - a, y0 + b, x1 - a, y1 - b);
-        LCD_line(frame_type, x1 - b, y1 - a, x0 + b, y1 - a);
-        LCD_line(frame_type, x0 + a, y1 - b, x0 + a, y0 + b);
-        b++;
-      }
-      y0 = y0 + a - 1;
-      y1 = y1 - a + 1;
-      x0 = x0 + a - 1;
-      x1 = x1 - a + 1;
+      if (step)
+        LCD_box_clip(fill, n0, m0, n1, m);
+      else
+        LCD_box_clip(fill, m0, n0, m, n1);
     }
-    else // rounded
-    {
-      b = 0;
-      for (a = 0; a < border_width; a++)
-      {
-        LCD_line(frame_type, x0 + 4 + b, y0 + a, x1 - 4 - b, y0 + a);
-        LCD_line(frame_type, x1 - a, y0 + 4 + b, x1 - a, y1 - 4 - b);
-        LCD_line(frame_type, x1 - 4 - b, y1 - a, x0 + 4 + b, y1 - a);
-        LCD_line(frame_type, x0 + a, y1 - 4 - b, x0 + a, y0 + 4 + b);
-
-        LCD_pixel(frame_type, x0 + 1 + b, y0 + 2 + b);
-        LCD_pixel(frame_type, x0 + 1 + b, y0 + 3 + b);
-        LCD_pixel(frame_type, x0 + 2 + b, y0 + 1 + b);
-        LCD_pixel(frame_type, x0 + 3 + b, y0 + 1 + b);
-
-        LCD_pixel(frame_type, x1 - 1 - b, y0 + 2 + b);
-        LCD_pixel(frame_type, x1 - 1 - b, y0 + 3 + b);
-        LCD_pixel(frame_type, x1 - 2 - b, y0 + 1 + b);
-        LCD_pixel(frame_type, x1 - 3 - b, y0 + 1 + b);
-
-        LCD_pixel(frame_type, x1 - 1 - b, y1 - 2 - b);
-        LCD_pixel(frame_type, x1 - 1 - b, y1 - 3 - b);
-        LCD_pixel(frame_type, x1 - 3 - b, y1 - 1 - b);
-        LCD_pixel(frame_type, x1 - 2 - b, y1 - 1 - b);
-
-        LCD_pixel(frame_type, x0 + 1 + b, y1 - 2 - b);
-        LCD_pixel(frame_type, x0 + 1 + b, y1 - 3 - b);
-        LCD_pixel(frame_type, x0 + 2 + b, y1 - 1 - b);
-        LCD_pixel(frame_type, x0 + 3 + b, y1 - 1 - b);
+    m0 = m + 1;
+  }
+}
 
-        b++;
-      }
-      y0 = y0 + a - 1;
+/**
+ * Integer square root (rounded down)
+ */
+static uint16_t LCD_isqrt(uint32_t a)
+{
+  uint32_t r = 0, bit = (uint32_t) 1 << 30;
+
+  while (bit > a)
+    bit >>= 2;
+  while (bit)
+  {
+    if (a >= r + bit)
+    {
+      a -= r + bit;
+      r = (r >> 1) + bit;
+    }
+    else
+      r >>= 1;
+    bit >>= 2;
+  }
+  return (uint16_t) r;
+}
+
+/**
+ * Add set/cleared bits of a column to the strip, another page or a column out of the
+ * window sends the strip first
+ */
+static void LCD_strip_put(lcd_strip *strip, uint8_t page, uint8_t col, uint8_t set, uint8_t clr)
+{
+  uint8_t i = col - strip->base;
+
+  if ((strip->lo > strip->hi) || (page != strip->page) || (col < strip->base)
+      || (i >= LINE_STRIP))
+  {
+    LCD_strip_flush(strip);
+    strip->page = page;
+    if (strip->dir > 0)
+      strip->base = col;
+    else
+      strip->base = (col >= LINE_STRIP - 1) ? col - (LINE_STRIP - 1) : 0;
+    i = col - strip->base;
+  }
+  strip->set[i] |= set;
+  strip->clr[i] |= clr;
+  if (i < strip->lo)
+    strip->lo = i;
+  if (i > strip->hi)
+    strip->hi = i;
+}
+
+/**
+ * Merge the strip into GDRAM (one read and one write of the changed columns)
+ */
+static void LCD_strip_flush(lcd_strip *strip)
+{
+  uint8_t buf[LINE_STRIP];
+  uint8_t n, i, b, first, end;
+
+  if (strip->lo > strip->hi)
+    return;
+  n = strip->hi - strip->lo + 1;
+  LCD_page_read(strip->page, strip->base + strip->lo, buf, n);
+  first = n;
+  end = 0;
+  for (i = 0; i < n; i++)
+  {
+    b = (buf[i] | strip->set[strip->lo + i]) & ~strip->clr[strip->lo + i];
+    strip->set[strip->lo + i] = 0;
+    strip->clr[strip->lo + i] = 0;
+    if (b != buf[i])
+    {
+      buf[i] = b;
+      if (first == n)
+        first = i;
+      end = i + 1;
+    }
+  }
+  if (first < end)
+    LCD_page_write(strip->page, strip->base + strip->lo + first, &buf[first], end - first);
+  strip->lo = 0xFF;
+  strip->hi = 0;
+}
+
+/**
+ * Filled box without a frame, every page is one read and one write of its column run
+ * @param fill: FILL_TYPE_WHITE, FILL_TYPE_BLACK, FILL_TYPE_GRAY (other patterns - gray)
+ * @param x
+ * @param y
+ * @param width
+ * @param height
+ */
+void LCD_box(fill_type fill, int16_t x, int16_t y, uint8_t width, uint8_t height)
+{
+  if (width && height)
+    LCD_box_clip(fill, vpX + x, vpY + y, vpX + x + width - 1, vpY + y + height - 1);
+}
+
+/**
+ * Horizontal run of pixels x0..x1 (in any order) in row y
+ */
+void LCD_hspan(fill_type fill, int16_t x0, int16_t x1, int16_t y)
+{
+  if (x0 > x1)
+    LCD_box_clip(fill, vpX + x1, vpY + y, vpX + x0, vpY + y);
+  else
+    LCD_box_clip(fill, vpX + x0, vpY + y, vpX + x1, vpY + y);
+}
+
+/**
+ * Vertical run of pixels y0..y1 (in any order) in column x, one byte per page
+ */
+void LCD_vspan(fill_type fill, int16_t x, int16_t y0, int16_t y1)
+{
+  if (y0 > y1)
+    LCD_box_clip(fill, vpX + x, vpY + y1, vpX + x, vpY + y0);
+  else
+    LCD_box_clip(fill, vpX + x, vpY + y0, vpX + x, vpY + y1);
+}
+
+/**
+ * Box in screen coordinates, corners included
+ */
+static void LCD_box_clip(fill_type fill, int16_t x0, int16_t y0, int16_t x1, int16_t y1)
+{
+  uint8_t page, mask;
+
+  if (x0 < clip->x0)
+    x0 = clip->x0;
+  if (x1 > clip->x1)
+    x1 = clip->x1;
+  if (y0 < clip->y0)
+    y0 = clip->y0;
+  if (y1 > clip->y1)
+    y1 = clip->y1;
+  if ((x0 > x1) || (y0 > y1) || (fill == FILL_TYPE_TRANSPARENT))
+    return;
+
+  for (page = y0 >> 3; page <= (y1 >> 3); page++)
+  {
+    mask = 0xFF;
+    if (page == (y0 >> 3))
+      mask &= 0xFF << (y0 & 7);
+    if (page == (y1 >> 3))
+      mask &= 0xFF >> (7 - (y1 & 7));
+    LCD_span(fill, page, x0, x1, mask);
+  }
+}
+
+/**
+ * Apply a fill to the "mask" rows of columns c0..c1 of a page, changed bytes are written
+ */
+static void LCD_span(fill_type fill, uint8_t page, uint8_t c0, uint8_t c1, uint8_t mask)
+{
+  uint8_t buf[SPAN_CHUNK];
+  uint8_t n, i, b, first, end;
+
+  while (c0 <= c1)
+  {
+    n = (c1 - c0 + 1 > SPAN_CHUNK) ? SPAN_CHUNK : c1 - c0 + 1;
+    LCD_page_read(page, c0, buf, n);
+    first = n;
+    end = 0;
+    for (i = 0; i < n; i++)
+    {
+      if (fill == FILL_TYPE_WHITE)
+        b = buf[i] & ~mask;
+      else if (fill == FILL_TYPE_BLACK)
+        b = buf[i] | mask;
+      else // checkerboard, anchored to the screen
+        b = (buf[i] & ~mask) | (((c0 + i) & 1 ? 0x55 : 0xAA) & mask);
+      if (b != buf[i])
+      {
+        buf[i] = b;
+        if (first == n)
+          first = i;
+        end = i + 1;
+      }
+    }
+    if (first < end)
+      LCD_page_write(page, c0 + first, &buf[first], end - first);
+    if (c1 - c0 < n)
+      break; // c1 may be 131 or 255
+    c0 += n;
+  }
+}
+
+#if LCD_FRAMEBUFFER
+/**
+ * Flood fill the area of the seed pixel color (4-connected) inside the clip rectangle.
+ * The area is taken as vertical runs, each filled as page byte masks. A stack entry is
+ * a column to scan over the rows of the run it was reached from, so the column behind
+ * is scanned again only where the new run sticks out. The stack has a fixed size.
+ * @param pixel_type: 0 - white, 1 - black
+ * @param x
+ * @param y
+ * @return 1 - done, 0 - the stack was full and a part of the area may be left
+ * (call again with a seed there)
+ */
+uint8_t LCD_flood(uint8_t pixel_type, int16_t x, int16_t y)
+{
+  uint8_t target = !pixel_type, done = 1;
+  uint8_t cx, y0, y1, r0, r1, row;
+  int8_t dir;
+
+  x += vpX;
+  y += vpY;
+  if ((x < clip->x0) || (x > clip->x1) || (y < clip->y0) || (y > clip->y1)
+      || (FB_PIXEL(x, y) != target))
+    return 1;
+
+  // the seed run is entered from both sides
+  y0 = y1 = y;
+  while ((y0 > clip->y0) && (FB_PIXEL(x, y0 - 1) == target))
+    y0--;
+  while ((y1 < clip->y1) && (FB_PIXEL(x, y1 + 1) == target))
+    y1++;
+  floodTop = 0;
+  LCD_flood_push(x, y0, y1, 1, target);
+  LCD_flood_push(x - 1, y0, y1, -1, target);
+  while (floodTop)
+  {
+    floodTop--;
+    cx = floodStack[floodTop].x;
+    y0 = floodStack[floodTop].y0;
+    y1 = floodStack[floodTop].y1;
+    dir = floodStack[floodTop].dir;
+
+    for (row = y0; row <= y1; row++)
+    {
+      if (FB_PIXEL(cx, row) != target)
+        continue;
+
+      // the whole run, it may be longer than the one it was reached from
+      r0 = r1 = row;
+      while ((r0 > clip->y0) && (FB_PIXEL(cx, r0 - 1) == target))
+        r0--;
+      while ((r1 < clip->y1) && (FB_PIXEL(cx, r1 + 1) == target))
+        r1++;
+      LCD_box_clip(pixel_type ? FILL_TYPE_BLACK : FILL_TYPE_WHITE, cx, r0, cx, r1);
+
+      done &= LCD_flood_push(cx + dir, r0, r1, dir, target);
+      if (r0 + 1 < y0)
+        done &= LCD_flood_push(cx - dir, r0, y0 - 2, -dir, target);
+      if (r1 > y1 + 1)
+        done &= LCD_flood_push(cx - dir, y1 + 2, r1, -dir, target);
+      row = r1 + 1;
+    }
+  }
+  return done;
+}
+
+/**
+ * Put a column range on the flood stack, columns out of the clip are skipped.
+ * A full stack drops the entries with nothing left to fill.
+ * @return 0 - no room, the range is lost
+ */
+static uint8_t LCD_flood_push(int16_t x, uint8_t y0, uint8_t y1, int8_t dir, uint8_t target)
+{
+  uint8_t i, n, row;
+
+  if ((x < clip->x0) || (x > clip->x1))
+    return 1;
+  if (floodTop == LCD_FLOOD_STACK)
+  {
+    for (i = 0, n = 0; i < floodTop; i++)
+    {
+      for (row = floodStack[i].y0; row <= floodStack[i].y1; row++)
+      {
+        if (FB_PIXEL(floodStack[i].x, row) == target)
+        {
+          floodStack[n++] = floodStack[i];
+          break;
+        }
+      }
+    }
+    floodTop = n;
+    if (floodTop == LCD_FLOOD_STACK)
+      return 0;
+  }
+  floodStack[floodTop].x = x;
+  floodStack[floodTop].y0 = y0;
+  floodStack[floodTop].y1 = y1;
+  floodStack[floodTop].dir = dir;
+  floodTop++;
+  return 1;
+}
+#endif
+
+/**
+ * Draw rectangle
+ * @param frame_type: LINE_TYPE_WHITE, LINE_TYPE_BLACK, LINE_TYPE_DOT, others - pattern
+ * @param ang_type: ANGLE_TYPE_RECT , ANGLE_TYPE_ROUNDED
+ * @param border_width: 0 - no, but with 1 px indent
+ * @param fill: FILL_TRANSPARENT, FILL_WHITE, FILL_GRAY, FILL_SEA, other pattern
+ * @param x0
+ * @param y0
+ * @param width
+ * @param height
+ */
+void LCD_rect(line_type frame_type, angle_type ang_type, uint8_t border_width,
+    fill_type fill, uint8_t x0, uint8_t y0, uint8_t width, uint8_t height)
+{
+  LCD_rect_clip(frame_type, ang_type, border_width, fill, vpX + x0, vpY + y0, width, height);
+}
+
+static void LCD_rect_clip(line_type frame_type, angle_type ang_type, uint8_t border_width,
+    fill_type fill, int16_t x0, int16_t y0, uint8_t width, uint8_t height)
+{
+
+  int16_t a, b, x1, y1;
+  fill_type fill_b;
+
+  char filler = 0;
+  char steep, vid;
+  int16_t t;
+  int deltax, deltay, error;
+  int16_t x, y, poi;
+  int16_t ystep;
+  int16_t zx0, zy0, zy1, zx1;
+  uint8_t RIS = 0;
+
+  x1 = x0 + width - 1;
+  y1 = y0 + height - 1;
+  // box outside the clip rectangle
+  if (!width || !height || (x1 < clip->x0) || (x0 > clip->x1) || (y1 < clip->y0)
+      || (y0 > clip->y1))
+    return;
+  if (border_width)
+  {
+    if ((ang_type == ANGLE_TYPE_RECT) && (frame_type <= LINE_TYPE_BLACK))
+    {
+      // solid frame: four boxes of page spans
+      a = border_width;
+      fill_b = frame_type ? FILL_TYPE_BLACK : FILL_TYPE_WHITE;
+      LCD_box_clip(fill_b, x0, y0, x1, (y0 + a - 1 < y1) ? y0 + a - 1 : y1);
+      if (y1 - a + 1 > y0 + a - 1)
+        LCD_box_clip(fill_b, x0, y1 - a + 1, x1, y1);
+      if (y1 - a > y0 + a - 1)
+      {
+        LCD_box_clip(fill_b, x0, y0 + a, (x0 + a - 1 < x1) ? x0 + a - 1 : x1, y1 - a);
+        if (x1 - a + 1 > x0 + a - 1)
+          LCD_box_clip(fill_b, x1 - a + 1, y0 + a, x1, y1 - a);
+      }
+      y0 = y0 + a - 1;
+      y1 = y1 - a + 1;
+      x0 = x0 + a - 1;
+      x1 = x1 - a + 1;
+    }
+    else if (ang_type == ANGLE_TYPE_RECT)
+    {
+      b = 0;
+      for (a = 0; a < border_width; a++)
+      {
+        LCD_line_clip(frame_type, x0 + b, y0 + a, x1 - b, y0 + a);
+        LCD_line_clip(frame_type, x1 - a, y0 + b, x1 - a, y1 - b);
+        LCD_line_clip(frame_type, x1 - b, y1 - a, x0 + b, y1 - a);
+        LCD_line_clip(frame_type, x0 + a, y1 - b, x0 + a, y0 + b);
+        b++;
+      }
+      y0 = y0 + a - 1;
+      y1 = y1 - a + 1;
+      x0 = x0 + a - 1;
+      x1 = x1 - a + 1;
+    }
+    else // rounded
+    {
+      b = 0;
+      for (a = 0; a < border_width; a++)
+      {
+        LCD_line_clip(frame_type, x0 + 4 + b, y0 + a, x1 - 4 - b, y0 + a);
+        LCD_line_clip(frame_type, x1 - a, y0 + 4 + b, x1 - a, y1 - 4 - b);
+        LCD_line_clip(frame_type, x1 - 4 - b, y1 - a, x0 + 4 + b, y1 - a);
+        LCD_line_clip(frame_type, x0 + a, y1 - 4 - b, x0 + a, y0 + 4 + b);
+
+        LCD_pixel_clip(frame_type, x0 + 1 + b, y0 + 2 + b);
+        LCD_pixel_clip(frame_type, x0 + 1 + b, y0 + 3 + b);
+        LCD_pixel_clip(frame_type, x0 + 2 + b, y0 + 1 + b);
+        LCD_pixel_clip(frame_type, x0 + 3 + b, y0 + 1 + b);
+
+        LCD_pixel_clip(frame_type, x1 - 1 - b, y0 + 2 + b);
+        LCD_pixel_clip(frame_type, x1 - 1 - b, y0 + 3 + b);
+        LCD_pixel_clip(frame_type, x1 - 2 - b, y0 + 1 + b);
+        LCD_pixel_clip(frame_type, x1 - 3 - b, y0 + 1 + b);
+
+        LCD_pixel_clip(frame_type, x1 - 1 - b, y1 - 2 - b);
+        LCD_pixel_clip(frame_type, x1 - 1 - b, y1 - 3 - b);
+        LCD_pixel_clip(frame_type, x1 - 3 - b, y1 - 1 - b);
+        LCD_pixel_clip(frame_type, x1 - 2 - b, y1 - 1 - b);
+
+        LCD_pixel_clip(frame_type, x0 + 1 + b, y1 - 2 - b);
+        LCD_pixel_clip(frame_type, x0 + 1 + b, y1 - 3 - b);
+        LCD_pixel_clip(frame_type, x0 + 2 + b, y1 - 1 - b);
+        LCD_pixel_clip(frame_type, x0 + 3 + b, y1 - 1 - b);
+
+        b++;
+      }
+      y0 = y0 + a - 1;
       y1 = y1 - a + 1;
       x0 = x0 + a - 1;
       x1 = x1 - a + 1;
@@ -447,9 +1571,9 @@ void LCD_rect(line_type frame_type, angle_type ang_type, uint8_t border_width,
         else
           vid = !(x & 1);
         if (steep)
-          LCD_pixel(vid, y, x);
+          LCD_pixel_clip(vid, y, x);
         else
-          LCD_pixel(vid, x, y);
+          LCD_pixel_clip(vid, x, y);
         error += deltay;
         if ((error << 1) >= deltax)
         {
@@ -484,31 +1608,115 @@ void LCD_string(char *str, uint8_t x, uint8_t y, font_type font,
 {
   uint8_t ptr = 0;
   uint8_t height, width;
+
+  LCD_font_scale(font, &width, &height);
+  LCD_cursor(x, y);
+  while (str[ptr] != 0)
+    LCD_symbol(str[ptr++], width, height, inverse);
+}
+
+/**
+ * Print UTF-8 string on screen (see LCD_string). The code points are mapped to chargen[]
+ * while printing: ASCII directly, the rest by chargen_cmap. Characters out of chargen[]
+ * are printed as '?'.
+ * @param str: 0-terminated UTF-8
+ */
+void LCD_string_utf8(const char *str, uint8_t x, uint8_t y, font_type font,
+    inverse_type inverse)
+{
+  uint8_t height, width, code;
+
+  LCD_font_scale(font, &width, &height);
+  LCD_cursor(x, y);
+  while (*str)
+  {
+    code = LCD_utf8_next(&str, &chargen_cmap);
+    LCD_symbol((code >= 0x20) ? (char) code : '?', width, height, inverse);
+  }
+}
+
+/**
+ * Print the first len bytes of a string (see LCD_string), for the text layout
+ * x and y may be off the screen, the symbols are clipped
+ * @param utf8: 1 - str is UTF-8 (see LCD_string_utf8)
+ */
+void LCD_string_part(const char *str, uint8_t len, int16_t x, int16_t y, font_type font,
+    inverse_type inverse, uint8_t utf8)
+{
+  const char *end = str + len;
+  uint8_t height, width, code;
+
+  LCD_font_scale(font, &width, &height);
+  cursorY = vpY + y;
+  cursorX = vpX + x;
+  LCD_cursor_addr();
+  while (str < end)
+  {
+    code = utf8 ? LCD_utf8_next(&str, &chargen_cmap) : (uint8_t) *str++;
+    LCD_symbol((code >= 0x20) ? (char) code : '?', width, height, inverse);
+  }
+}
+
+/**
+ * Width of a string printed by LCD_string, without the empty column after the last symbol
+ */
+uint16_t LCD_string_width(const char *str, font_type font)
+{
+  uint8_t height, width;
+
+  LCD_font_scale(font, &width, &height);
+  return tool_strlen((char *) str) * (5 * width + 1) - ((*str) ? 1 : 0);
+}
+
+/**
+ * Width of a UTF-8 string printed by LCD_string_utf8
+ */
+uint16_t LCD_string_width_utf8(const char *str, font_type font)
+{
+  uint8_t height, width;
+  uint16_t n = 0;
+
+  LCD_font_scale(font, &width, &height);
+  while (*str)
+  {
+    LCD_utf8_next(&str, 0); // one symbol per character, the same as printing
+    n++;
+  }
+  return n * (5 * width + 1) - (n ? 1 : 0);
+}
+
+/**
+ * Rows of a symbol cell: 8 or 16 for the double height
+ */
+uint8_t LCD_string_height(font_type font)
+{
+  uint8_t height, width;
+
+  LCD_font_scale(font, &width, &height);
+  return 8 << height;
+}
+
+static void LCD_font_scale(font_type font, uint8_t *width, uint8_t *height)
+{
   switch (font)
   {
-    case FONT_TYPE_5x8:
-      width = 1;
-      height = 0;
-      break;
     case FONT_TYPE_5x15:
-      width = 1;
-      height = 1;
+      *width = 1;
+      *height = 1;
       break;
     case FONT_TYPE_10x15:
-      width = 2;
-      height = 1;
+      *width = 2;
+      *height = 1;
       break;
     case FONT_TYPE_10x8:
-      width = 2;
-      height = 0;
+      *width = 2;
+      *height = 0;
       break;
     default:
+      *width = 1;
+      *height = 0;
       break;
   }
-
-  LCD_cursor(x, y);
-  while (str[ptr] != 0)
-    LCD_symbol(str[ptr++], width, height, inverse);
 }
 
 /**
@@ -521,15 +1729,33 @@ void LCD_string(char *str, uint8_t x, uint8_t y, font_type font,
 void LCD_symbol(char code, uint8_t width, uint8_t height, inverse_type inverse)
 {
 	uint8_t lcdBuff[4] = {0};
-  uint8_t vert_offset, b, a, c, z, widthf, heightf;
-  uint32_t buf, fon, vline, mask, mask1, mask2;
-  uint16_t chargen_index = (code - 0x20) * 5; // character generator(chargen) consists of symbols strating
-  //from 0x20 symbol (space). 5 - count of bytes, that determinate char:
-  // each byte is vertical pixels(at total 5x8 pixels for one character)
+  uint8_t vert_offset, b, a, c, widthf, heightf;
+  uint32_t buf, fon, back, vline, mask, mask1, mask2, cm;
+  uint32_t cols[5];
+  int16_t lo, hi;
 
   widthf = (width + 1) & 0x07; // width from 0 to 6
   heightf = height & 0x01; // hight only 0 or 1
 
+  // clip rows of the 4 pages written from the cursor page (cm), cull the whole glyph
+  cm = 0;
+  if (cursorY >= 0)
+  {
+    lo = clip->y0 - ((cursorY >> 3) ? (cursorY >> 3) - 1 : 0) * 8;
+    hi = clip->y1 - ((cursorY >> 3) ? (cursorY >> 3) - 1 : 0) * 8;
+    if (lo < 0)
+      lo = 0;
+    if (hi > 31)
+      hi = 31;
+    if (lo <= hi)
+      cm = (0xFFFFFFFF >> (31 - hi)) & (0xFFFFFFFF << lo);
+  }
+  if (!cm || (cursorX > clip->x1) || (cursorX + 5 * (widthf - 1) < clip->x0))
+  {
+    cursorX += 5 * (widthf - 1) + 1;
+    return;
+  }
+
   // vertical offset
   if ((cursorY / 8) == 0)
   {
@@ -540,81 +1766,44 @@ void LCD_symbol(char code, uint8_t width, uint8_t height, inverse_type inverse)
     vert_offset = (cursorY % 8) + 8;
   }
 
+  LCD_symbol_columns(code, heightf, inverse, cols);
+
   // go by bytes in chargen
   for (b = 0; b < 5; b++)
   {
-    if (heightf == 0) //char-s of single (1) height
+    vline = cols[b] << vert_offset; //+1      (  )
+    if ((uint8_t) inverse)
     {
-      if ((uint8_t) inverse)
-      {
-        vline = ~(uint8_t) chargen[chargen_index + b];
-      }
-      else
-      {
-        vline = chargen[chargen_index + b]; //else single load
-      }
-
-      vline = vline << vert_offset;
-      if ((uint8_t) inverse)
-      {
-        TOOL_SET_BIT(vline, vert_offset-1);
-      }
-    }
-    else //char-s of double (2) height
-    {
-      if ((uint8_t) inverse)
-      {
-        buf = ~chargen[chargen_index + b];
-      }
-      else
-      {
-        buf = chargen[chargen_index + b];
-      }
-      mask = 1;
-      vline = 0;
-      for (z = 0; z < 8; z++)
-      {
-        vline = vline >> 2;
-        if (buf & mask)
-        {
-          vline |= 0xC000; //0b11000000 00000000;
-        }
-        mask = mask << 1;
-      }
-      vline = vline << vert_offset; //+1      (  )
-      if ((uint8_t) inverse)
-      {
-        TOOL_SET_BIT(vline, vert_offset-1);
-      }
+      TOOL_SET_BIT(vline, vert_offset-1);
     }
 
     // copy column of pixels by horisont widthf-1 times
     for (a = 1; a < widthf; a++)
     {
-      if (cursorX > 131) // out of display 131
+      if ((cursorX < clip->x0) || (cursorX > clip->x1)) // clipped column
       {
-				lcdBuff[0] = SET_RAM_ADDR_CTRL(WRAP_AROUND,INC_COL_FIRST,PAGE_INC_DIR_NORMAL);
-        I2C_WrBuf(LcdCmd, lcdBuff, 1);
-        return;
+        cursorX++;
+        continue;
       }
-      LCD_cursor(cursorX, cursorY);
+      LCD_cursor_addr();
       // read all column (4 page)
 			lcdBuff[0] = SET_RAM_ADDR_CTRL(WRAP_AROUND,INC_PAGE_FIRST,PAGE_INC_DIR_NORMAL);
-			I2C_WrBuf(LcdCmd, lcdBuff, 1);
+			LCD_write(LcdCmd, lcdBuff, 1);
 
 
       //read all display column (32 bit)
       {
-        uint8_t buf[6]; //0-th byte and 5-fth are fake
-        I2C_RdBuf(LcdData, buf, sizeof(buf));
+        uint8_t buf[4];
+        LCD_read_gdram(buf, sizeof(buf));
 
-				fon = buf[4];
-        fon <<= 8;
-        fon += buf[3];
+				fon = buf[3];
         fon <<= 8;
         fon += buf[2];
         fon <<= 8;
         fon += buf[1];
+        fon <<= 8;
+        fon += buf[0];
+        back = fon;
       }
 
       //generate mask for clear vertical line region
@@ -658,15 +1847,16 @@ void LCD_symbol(char code, uint8_t width, uint8_t height, inverse_type inverse)
       fon = fon & mask; //clean part, which will be replaced
       // and apply char line
       buf = vline | fon;
+      buf = (back & ~cm) | (buf & cm); // rows outside the clip keep the background
 
       // correct cursor
-      LCD_cursor(cursorX, cursorY);
+      LCD_cursor_addr();
       cursorX++;
 
       {
 //        uint8_t buf[] = { 0b10001011 }; // move by page +
 				uint8_t buf[] = { SET_RAM_ADDR_CTRL(WRAP_AROUND,INC_PAGE_FIRST,PAGE_INC_DIR_NORMAL) }; // move by page +
-        I2C_WrBuf(LcdCmd, buf, sizeof(buf));
+        LCD_write(LcdCmd, buf, sizeof(buf));
       }
 
       {
@@ -676,31 +1866,39 @@ void LCD_symbol(char code, uint8_t width, uint8_t height, inverse_type inverse)
 				buff[2] = (buf >> 16) & 0xff;
 				buff[3] = (buf >> 24) & 0xff ;
  
-        I2C_WrBuf(0x70 | 2, buff, sizeof(buf));
+        LCD_write(LcdData, buff, sizeof(buf));
       }
     }
   }
 
-  LCD_cursor(cursorX, cursorY); //correct cursor
+  if ((cursorX < clip->x0) || (cursorX > clip->x1)) // clipped separator
+  {
+    cursorX++;
+    lcdBuff[0] = SET_RAM_ADDR_CTRL(WRAP_AROUND,INC_COL_FIRST,PAGE_INC_DIR_NORMAL);
+    LCD_write(LcdCmd, lcdBuff, 1);
+    return;
+  }
+  LCD_cursor_addr(); //correct cursor
 
   // == Clear separator line (1px between chars) ==
   {
 //    uint8_t buf[] = { 0b10001011 }; // move by page +
 		uint8_t buf[] = { SET_RAM_ADDR_CTRL(WRAP_AROUND,INC_PAGE_FIRST,PAGE_INC_DIR_NORMAL) }; // move by page +
-    I2C_WrBuf(LcdCmd, buf, sizeof(buf));
+    LCD_write(LcdCmd, buf, sizeof(buf));
   }
 
   {
-    uint8_t buf[6];
-    I2C_RdBuf(LcdData, buf, sizeof(buf));
+    uint8_t buf[4];
+    LCD_read_gdram(buf, sizeof(buf));
 
-    fon = buf[4];
-    fon = fon << 8;
-    fon += buf[3];
+    fon = buf[3];
     fon = fon << 8;
     fon += buf[2];
     fon = fon << 8;
     fon += buf[1];
+    fon = fon << 8;
+    fon += buf[0];
+    back = fon;
   }
 
   //generate mask for clear vertical line region
@@ -743,17 +1941,17 @@ void LCD_symbol(char code, uint8_t width, uint8_t height, inverse_type inverse)
     }
     fon = fon | mask;
   }
-  buf = fon;
+  buf = (back & ~cm) | (fon & cm);
 
   // correct cursor
-  LCD_cursor(cursorX, cursorY);
+  LCD_cursor_addr();
   cursorX++;
 
   {
 //    uint8_t buf[] = { 0b10001011 };
 //    I2C_WrBuf(0x70, buf, sizeof(buf));
 		uint8_t buf = SET_RAM_ADDR_CTRL(WRAP_AROUND,INC_PAGE_FIRST,PAGE_INC_DIR_NORMAL);
-		I2C_WrBuf(LcdCmd, &buf, sizeof(buf));
+		LCD_write(LcdCmd, &buf, sizeof(buf));
 		
   }
 
@@ -764,15 +1962,648 @@ void LCD_symbol(char code, uint8_t width, uint8_t height, inverse_type inverse)
 		buff[1] = (buf >> 8) & 0xff;
 		buff[2] = (buf >> 16) & 0xff;
 		buff[3] = (buf >> 24) & 0xff;
-    I2C_WrBuf(LcdData, buff, sizeof(buf));
+    LCD_write(LcdData, buff, sizeof(buf));
   }
 
   {
 //    uint8_t buf[] = { 0b10001001 };
 		uint8_t buf = SET_RAM_ADDR_CTRL(WRAP_AROUND,INC_COL_FIRST,PAGE_INC_DIR_NORMAL);
-    I2C_WrBuf(LcdCmd, &buf, sizeof(buf));
+    LCD_write(LcdCmd, &buf, sizeof(buf));
+  }
+
+}
+
+/**
+ * Columns of a chargen[] symbol scaled to the cell height and inverted, bit 0 - the lowest
+ * row of the cell. The double height columns are kept in the glyph cache (a missing symbol
+ * takes the least recently used entry), the single height ones are chargen[] bytes as is.
+ * @param cols: 5 columns, filled by the function
+ */
+static void LCD_symbol_columns(char code, uint8_t heightf, inverse_type inverse,
+    uint32_t *cols)
+{
+  uint16_t chargen_index = (code - 0x20) * 5; // character generator(chargen) consists of symbols strating
+  //from 0x20 symbol (space). 5 - count of bytes, that determinate char:
+  // each byte is vertical pixels(at total 5x8 pixels for one character)
+  uint32_t buf, mask, vline;
+  uint8_t b, z;
+#if LCD_GLYPH_CACHE_SIZE
+  uint8_t inv, h, e, *link;
+#endif
+
+  if (heightf == 0) //char-s of single (1) height
+  {
+    for (b = 0; b < 5; b++)
+    {
+      if ((uint8_t) inverse)
+      {
+        cols[b] = ~(uint8_t) chargen[chargen_index + b];
+      }
+      else
+      {
+        cols[b] = chargen[chargen_index + b]; //else single load
+      }
+    }
+    return;
+  }
+
+#if LCD_GLYPH_CACHE_SIZE
+  inv = (uint8_t) inverse ? 1 : 0;
+  h = GLYPH_HASH(code, inv);
+  for (e = glyphBucket[h]; e != GLYPH_NONE; e = glyphSlot[e].chain)
+  {
+    if ((glyphSlot[e].code == code) && (glyphSlot[e].inverse == inv))
+    {
+      LCD_glyph_newest(e, 1);
+      glyphHits++;
+      for (b = 0; b < 5; b++)
+        cols[b] = glyphSlot[e].col[b];
+      return;
+    }
+  }
+  glyphMisses++;
+#endif
+
+  //char-s of double (2) height
+  for (b = 0; b < 5; b++)
+  {
+    if ((uint8_t) inverse)
+    {
+      buf = ~chargen[chargen_index + b];
+    }
+    else
+    {
+      buf = chargen[chargen_index + b];
+    }
+    mask = 1;
+    vline = 0;
+    for (z = 0; z < 8; z++)
+    {
+      vline = vline >> 2;
+      if (buf & mask)
+      {
+        vline |= 0xC000; //0b11000000 00000000;
+      }
+      mask = mask << 1;
+    }
+    cols[b] = vline;
+  }
+
+#if LCD_GLYPH_CACHE_SIZE
+  if (glyphUsed < LCD_GLYPH_CACHE_SIZE)
+  {
+    e = glyphUsed++;
+    LCD_glyph_newest(e, 0);
+  }
+  else
+  {
+    // the least recently used symbol leaves its bucket
+    e = glyphOldest;
+    link = &glyphBucket[GLYPH_HASH(glyphSlot[e].code, glyphSlot[e].inverse)];
+    while (*link != e)
+      link = &glyphSlot[*link].chain;
+    *link = glyphSlot[e].chain;
+    LCD_glyph_newest(e, 1);
+  }
+  glyphSlot[e].code = code;
+  glyphSlot[e].inverse = inv;
+  glyphSlot[e].chain = glyphBucket[h];
+  glyphBucket[h] = e;
+  for (b = 0; b < 5; b++)
+    glyphSlot[e].col[b] = (uint16_t) cols[b];
+#endif
+}
+
+#if LCD_GLYPH_CACHE_SIZE
+/**
+ * Make an entry the most recently used one
+ * @param linked: the entry is in the LRU list
+ */
+static void LCD_glyph_newest(uint8_t e, uint8_t linked)
+{
+  lcd_glyph_slot *g = &glyphSlot[e];
+
+  if (linked)
+  {
+    if (e == glyphNewest)
+      return;
+    glyphSlot[g->newer].older = g->older;
+    if (g->older != GLYPH_NONE)
+      glyphSlot[g->older].newer = g->newer;
+    else
+      glyphOldest = g->newer;
+  }
+  g->older = glyphNewest;
+  g->newer = GLYPH_NONE;
+  if (glyphNewest != GLYPH_NONE)
+    glyphSlot[glyphNewest].newer = e;
+  else
+    glyphOldest = e;
+  glyphNewest = e;
+}
+#endif
+
+static void LCD_glyph_clear(void)
+{
+#if LCD_GLYPH_CACHE_SIZE
+  uint8_t i;
+
+  for (i = 0; i < GLYPH_BUCKETS; i++)
+    glyphBucket[i] = GLYPH_NONE;
+  glyphUsed = 0;
+  glyphNewest = GLYPH_NONE;
+  glyphOldest = GLYPH_NONE;
+#endif
+}
+
+/**
+ * Send everything queued in the write-combining buffer
+ * Call it when the drawing is done (e.g. at the end of a frame).
+ */
+void LCD_sync(void)
+{
+#if LCD_FRAMEBUFFER
+  LCD_wc_flush();
+  LCD_fb_flush();
+#else
+  LCD_wc_addr();
+  LCD_wc_flush();
+#endif
+}
+
+/**
+ * Driver statistics
+ * I2C traffic and errors are cumulative since reset. Flushes are framebuffer pushes by
+ * LCD_sync() (LCD_clear/LCD_fill without the framebuffer),
+ * their durations are measured with the DWT cycle counter (enabled by LCD_init).
+ * @param stats: filled by the function
+ */
+void LCD_stats(lcd_stats *stats)
+{
+  i2c_traffic traffic;
+  i2c_err_counters err;
+  uint32_t cycles_per_us = SystemCoreClock / 1000000;
+
+  I2C_GetTraffic(&traffic);
+  I2C_GetErrCounters(&err);
+
+  stats->bytes_written = traffic.bytes_written;
+  stats->bytes_read = traffic.bytes_read;
+  stats->transactions = traffic.transactions;
+  stats->starts = traffic.starts;
+  stats->timeouts = err.timeouts;
+  stats->retries = err.retries;
+
+  stats->cache_hits = cacheHits;
+  stats->cache_misses = cacheMisses;
+  stats->glyph_hits = glyphHits;
+  stats->glyph_misses = glyphMisses;
+  stats->flushes = flushCount;
+  stats->dirty_bytes = flushDirty;
+  stats->flush_us_max = flushCyclesMax / cycles_per_us;
+  if (flushCount)
+  {
+    stats->dirty_bytes_avg = flushDirty / flushCount;
+    stats->flush_us_avg = (uint32_t) (flushCyclesSum / flushCount / cycles_per_us);
+  }
+  else
+  {
+    stats->dirty_bytes_avg = 0;
+    stats->flush_us_avg = 0;
+  }
+}
+
+/**
+ * Reset all the counters
+ */
+void LCD_stats_reset(void)
+{
+  I2C_ResetTraffic();
+  I2C_ResetErrCounters();
+  cacheHits = 0;
+  cacheMisses = 0;
+  glyphHits = 0;
+  glyphMisses = 0;
+  flushCount = 0;
+  flushDirty = 0;
+  flushCyclesMax = 0;
+  flushCyclesSum = 0;
+}
+
+static void LCD_write(uint8_t type, uint8_t *buf, uint32_t cnt)
+{
+#if !LCD_FRAMEBUFFER
+  uint8_t direct, page = 0, col = 0, known = 0;
+  uint8_t *data = 0;
+  uint32_t len = 0;
+#endif
+
+  if (type == LcdCmd)
+  {
+    while (cnt--)
+      LCD_wc_cmd(*buf++);
+    return;
+  }
+
+#if LCD_FRAMEBUFFER
+  // GDRAM data lands in the framebuffer, LCD_sync() sends the changed bytes
+  if (wantSet)
+  {
+    wcPage = wantPage;
+    wcCol = wantCol;
+    wantSet = 0;
+  }
+  while (cnt--)
+  {
+    if ((wcPage < 8) && (fb[wcPage][wcCol] != *buf))
+    {
+      fb[wcPage][wcCol] = *buf;
+      if (wcCol < fbDirtyMin[wcPage])
+        fbDirtyMin[wcPage] = wcCol;
+      if (wcCol > fbDirtyMax[wcPage])
+        fbDirtyMax[wcPage] = wcCol;
+    }
+    buf++;
+    LCD_fb_next(&wcPage, &wcCol);
+  }
+#else
+  LCD_wc_addr();
+  direct = cnt >= sizeof(wcBuf); // a long run goes out as a transaction of its own
+  if (direct)
+  {
+    LCD_wc_flush();
+    page = wcPage;
+    col = wcCol;
+    known = wcKnown;
+    data = buf;
+    len = cnt;
+  }
+  while (cnt--)
+  {
+#if LCD_GDRAM_CACHE_SIZE
+    if (wcKnown)
+      LCD_cache_put(wcPage, wcCol, *buf);
+    else
+      LCD_cache_clear(); // can't tell which byte is overwritten
+#endif
+    if (!direct)
+      LCD_wc_put(LcdData, *buf);
+    buf++;
+
+    // follow the address counter of the controller
+    if (wcIncPage)
+    {
+      if (++wcPage > 8)
+        wcKnown = 0;
+    }
+    else if (++wcCol > 131)
+    {
+      wcKnown = 0;
+    }
+  }
+  if (direct)
+    LCD_data_send(page, col, known, data, len);
+#endif
+  wantPage = wcPage;
+  wantCol = wcCol;
+}
+
+#if !LCD_FRAMEBUFFER
+static uint32_t LCD_read(uint8_t type, uint8_t *buf, uint32_t cnt)
+{
+  uint32_t err;
+
+  // the controller returns a dummy byte after every address setting, so the
+  // requested address is always sent here (even if it is where the counter is)
+  if (wantSet)
+    wcKnown = 0;
+  LCD_wc_addr();
+  LCD_wc_flush();
+  err = I2C_RdBuf(type, buf, cnt);
+  // reading moves the counter too
+  wcKnown = 0;
+  return err;
+}
+#endif
+
+static void LCD_wc_cmd(uint8_t cmd)
+{
+  if (wcParam)
+  {
+    wcParam = 0;
+  }
+  else if (cmd <= 0x0F) // column LSB
+  {
+    wantCol = (wantCol & 0xF0) | cmd;
+    wantSet = 1;
+    return;
+  }
+  else if (cmd <= 0x1F) // column MSB
+  {
+    wantCol = (wantCol & 0x0F) | ((cmd & 0x0F) << 4);
+    wantSet = 1;
+    return;
+  }
+  else if ((cmd & 0xF0) == SET_PAGE_ADDR(0))
+  {
+    wantPage = cmd & 0x0F;
+    wantSet = 1;
+    return;
   }
+  else if ((cmd & 0xF8) == SET_RAM_ADDR_CTRL(0, 0, 0))
+  {
+    wcIncPage = (cmd & INC_PAGE_FIRST) != 0;
+#if LCD_FRAMEBUFFER
+    return; // addressing is emulated, LCD_fb_flush() sets its own mode
+#endif
+  }
+  else if (cmd == SYSTEM_RESET)
+  {
+    LCD_cache_clear();
+    wcKnown = 0;
+    wantSet = 0;
+    wantPage = 0;
+    wantCol = 0;
+    wcIncPage = 0;
+  }
+  else if ((cmd == SET_BIAS_POT) || ((cmd >= 0xF1) && (cmd <= 0xF3))) // double-byte
+  {
+    wcParam = 1;
+  }
+  LCD_wc_put(LcdCmd, cmd);
+}
+
+/**
+ * Read "cnt" (up to 8) GDRAM bytes from the address set by the preceding address
+ * commands. The dummy read is done here. Bytes found in the cache don't touch the bus.
+ * A failed read is repeated from the address, the bytes of a read that still fails
+ * are not cached.
+ */
+static void LCD_read_gdram(uint8_t *buf, uint8_t cnt)
+{
+#if LCD_FRAMEBUFFER
+  uint8_t i, page = wantPage, col = wantCol;
+
+  for (i = 0; i < cnt; i++)
+  {
+    buf[i] = (page < 8) ? fb[page][col] : 0;
+    LCD_fb_next(&page, &col);
+  }
+#else
+  uint8_t tmp[9];
+  uint8_t i, page, col, attempt;
+  uint32_t err;
+
+#if LCD_GDRAM_CACHE_SIZE
+  page = wantPage;
+  col = wantCol;
+  for (i = 0; i < cnt; i++)
+  {
+    if (!LCD_cache_get(page, col, &buf[i]))
+      break;
+    if (wcIncPage)
+      page++;
+    else
+      col++;
+  }
+  if (i == cnt)
+  {
+    cacheHits++;
+    return;
+  }
+  cacheMisses++;
+#endif
 
+  page = wantPage;
+  col = wantCol;
+  err = LCD_read(LcdData, tmp, cnt + 1); // 0-th byte is fake
+  for (attempt = 0; err && (attempt < LCD_DATA_RETRIES); attempt++)
+  {
+    wantSet = 1; // the address again, the counter is unknown now
+    err = LCD_read(LcdData, tmp, cnt + 1);
+  }
+  for (i = 0; i < cnt; i++)
+  {
+    buf[i] = tmp[i + 1];
+#if LCD_GDRAM_CACHE_SIZE
+    if (!err)
+      LCD_cache_put(page, col, buf[i]);
+#endif
+    if (wcIncPage)
+      page++;
+    else
+      col++;
+  }
+#endif
+}
+
+#if LCD_FRAMEBUFFER
+/**
+ * Emulate the address counter (wrap around on)
+ */
+static void LCD_fb_next(uint8_t *page, uint8_t *col)
+{
+  if (wcIncPage)
+  {
+    if (++*page > 8)
+    {
+      *page = 0;
+      if (++*col > 131)
+        *col = 0;
+    }
+  }
+  else if (++*col > 131)
+  {
+    *col = 0;
+    if (++*page > 8)
+      *page = 0;
+  }
+}
+
+/**
+ * Fill the framebuffer, only changed bytes become dirty
+ */
+static void LCD_fb_fill(uint8_t byte)
+{
+  uint8_t page, col;
+
+  for (page = 0; page < 8; page++)
+  {
+    for (col = 0; col < 132; col++)
+    {
+      if (fb[page][col] != byte)
+      {
+        fb[page][col] = byte;
+        if (col < fbDirtyMin[page])
+          fbDirtyMin[page] = col;
+        fbDirtyMax[page] = col;
+      }
+    }
+  }
+}
+
+/**
+ * Send the dirty span of every page, one data transaction per page. A page that fails
+ * keeps its span dirty.
+ */
+static void LCD_fb_flush(void)
+{
+  uint8_t page, lcdBuff[4], len = 0;
+  uint16_t dirty = 0;
+
+  for (page = 0; page < 8; page++)
+  {
+    if (fbDirtyMin[page] > fbDirtyMax[page])
+      continue;
+    if (!dirty)
+    {
+      LCD_flush_begin();
+      lcdBuff[len++] = SET_RAM_ADDR_CTRL(WRAP_AROUND,INC_COL_FIRST,PAGE_INC_DIR_NORMAL);
+    }
+    lcdBuff[len++] = SET_PAGE_ADDR(page);
+    lcdBuff[len++] = SET_COL_ADDR_LSB(fbDirtyMin[page] & 0x0f);
+    lcdBuff[len++] = SET_COL_ADDR_MSB(fbDirtyMin[page] >> 4);
+    if (I2C_WrBuf(LcdCmd, lcdBuff, len) || I2C_WrBuf(LcdData, &fb[page][fbDirtyMin[page]],
+        fbDirtyMax[page] - fbDirtyMin[page] + 1))
+    {
+      // the span stays dirty, the next LCD_sync() sends it again
+      len = 0;
+      continue;
+    }
+    dirty += fbDirtyMax[page] - fbDirtyMin[page] + 1;
+    fbDirtyMin[page] = 0xFF;
+    fbDirtyMax[page] = 0;
+    len = 0;
+  }
+  if (dirty)
+    LCD_flush_end(dirty);
+}
+#endif
+
+#if LCD_GDRAM_CACHE_SIZE
+static uint8_t LCD_cache_get(uint8_t page, uint8_t col, uint8_t *byte)
+{
+  uint16_t tag = page * 132 + col;
+  uint16_t idx = tag & (LCD_GDRAM_CACHE_SIZE - 1);
+
+  if ((page > 8) || (col > 131) || (cacheTag[idx] != tag))
+    return 0;
+  *byte = cacheData[idx];
+  return 1;
+}
+
+static void LCD_cache_put(uint8_t page, uint8_t col, uint8_t byte)
+{
+  uint16_t tag = page * 132 + col;
+  uint16_t idx = tag & (LCD_GDRAM_CACHE_SIZE - 1);
+
+  if ((page > 8) || (col > 131))
+    return;
+  cacheTag[idx] = tag;
+  cacheData[idx] = byte;
+  cacheEmpty = 0;
+}
+#endif
+
+static void LCD_cache_clear(void)
+{
+#if LCD_GDRAM_CACHE_SIZE
+  uint16_t i;
+
+  if (cacheEmpty)
+    return;
+  for (i = 0; i < LCD_GDRAM_CACHE_SIZE; i++)
+    cacheTag[i] = CACHE_TAG_NONE;
+  cacheEmpty = 1;
+#endif
+}
+
+#if !LCD_FRAMEBUFFER
+static void LCD_wc_addr(void)
+{
+  if (!wantSet)
+    return;
+  wantSet = 0;
+  if (wcKnown && (wcPage == wantPage) && (wcCol == wantCol))
+    return; // in sequence, nothing to send
+
+  LCD_wc_put(LcdCmd, SET_PAGE_ADDR(wantPage));
+  LCD_wc_put(LcdCmd, SET_COL_ADDR_LSB(wantCol & 0x0f));
+  LCD_wc_put(LcdCmd, SET_COL_ADDR_MSB(wantCol >> 4));
+  wcPage = wantPage;
+  wcCol = wantCol;
+  wcKnown = 1;
+}
+#endif
+
+static void LCD_wc_put(uint8_t type, uint8_t byte)
+{
+  if ((wcLen == sizeof(wcBuf)) || (wcType != type))
+    LCD_wc_flush();
+  if (!wcLen && (type == LcdData))
+  {
+    wcRunPage = wcPage;
+    wcRunCol = wcCol;
+    wcRunKnown = wcKnown;
+  }
+  wcType = type;
+  wcBuf[wcLen++] = byte;
+}
+
+static void LCD_wc_flush(void)
+{
+  if (wcLen && (wcType == LcdData))
+    LCD_data_send(wcRunPage, wcRunCol, wcRunKnown, wcBuf, wcLen);
+  else if (wcLen)
+    I2C_WrBuf(wcType, wcBuf, wcLen);
+  wcLen = 0;
+}
+
+/**
+ * Send GDRAM data that starts at page, col. A failed transfer may have moved the address
+ * counter, so the address is sent again before every repeated attempt. If the data can't
+ * be sent, the address counter and the GDRAM contents are no longer known.
+ * @param known: page and col are the address, 0 - the transfer can't be repeated
+ * @return I2C_ERR_NONE or the error
+ */
+static uint32_t LCD_data_send(uint8_t page, uint8_t col, uint8_t known, uint8_t *buf,
+    uint32_t cnt)
+{
+  uint8_t lcdBuff[3], attempt;
+  uint32_t err;
+
+  err = I2C_WrBuf(LcdData, buf, cnt);
+  for (attempt = 0; err && known && (attempt < LCD_DATA_RETRIES); attempt++)
+  {
+    lcdBuff[0] = SET_PAGE_ADDR(page);
+    lcdBuff[1] = SET_COL_ADDR_LSB(col & 0x0f);
+    lcdBuff[2] = SET_COL_ADDR_MSB(col >> 4);
+    err = I2C_WrBuf(LcdCmd, lcdBuff, sizeof(lcdBuff));
+    if (!err)
+      err = I2C_WrBuf(LcdData, buf, cnt);
+  }
+  if (err)
+  {
+    wcKnown = 0;
+    LCD_cache_clear();
+  }
+  return err;
+}
+
+static void LCD_flush_begin(void)
+{
+  flushStart = DWT->CYCCNT;
+}
+
+static void LCD_flush_end(uint16_t dirty)
+{
+  uint32_t cycles = DWT->CYCCNT - flushStart;
+
+  flushCount++;
+  flushDirty += dirty;
+  flushCyclesSum += cycles;
+  if (cycles > flushCyclesMax)
+    flushCyclesMax = cycles;
 }
 
 /**
@@ -781,10 +2612,24 @@ void LCD_symbol(char code, uint8_t width, uint8_t height, inverse_type inverse)
  * @param Y 0-LCD_HEIGHT
  */
 void LCD_cursor(uint8_t x, uint8_t y)
+{
+  cursorY = vpY + y;
+  cursorX = vpX + x;
+  LCD_cursor_addr();
+}
+
+/**
+ * Send the GDRAM address of the cursor (if it is on the screen)
+ */
+static void LCD_cursor_addr(void)
 {
 	uint8_t lcdBuffer[3] = {0};
-  cursorY = y;
-  cursorX = x;
+	uint8_t x, y;
+
+  if ((cursorX < 0) || (cursorX > 131) || (cursorY < 0) || (cursorY > 255))
+    return;
+  x = cursorX;
+  y = cursorY;
 
 /*
 	if ((y / 8) == 0)
@@ -802,7 +2647,7 @@ void LCD_cursor(uint8_t x, uint8_t y)
 	lcdBuffer[0] = SET_PAGE_ADDR(y);
 	lcdBuffer[1] = SET_COL_ADDR_LSB(x & 0x0f);
 	lcdBuffer[2] = SET_COL_ADDR_MSB(x>>4);
-	I2C_WrBuf(LcdCmd, lcdBuffer, sizeof(lcdBuffer));
+	LCD_write(LcdCmd, lcdBuffer, sizeof(lcdBuffer));
 
 }
 